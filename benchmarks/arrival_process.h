@@ -0,0 +1,303 @@
+// ArrivalProcess / ArrivalPacer - configurable load generation for benchmarks.
+//
+// The perftests publish in tight loops, which only exercises the saturated
+// path. Real feeds are bursty, and BatchEventProcessor's batching behaves very
+// differently under bursts, so scenarios can pace their producers with one of
+// these arrival processes instead.
+//
+// Spec strings (see ArrivalProcess::parse):
+//   max                                  no pacing (saturation)
+//   constant:RATE                        fixed gap, RATE events/s
+//   poisson:RATE                         exponential gaps, mean RATE events/s
+//   onoff:RATE:ON_US:OFF_US              Poisson at RATE for ON_US, then silent for OFF_US
+//   diurnal:MIN_RATE:MAX_RATE:PERIOD_MS  Poisson whose rate ramps MIN -> MAX -> MIN over PERIOD_MS
+//   replay:FILE                          inter-arrival gaps in ns read from FILE (looped)
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "disruptor/wait_strategy.h"
+
+class ArrivalProcess
+{
+public:
+    enum class Kind
+    {
+        Max,
+        Constant,
+        Poisson,
+        OnOff,
+        Diurnal,
+        Replay
+    };
+
+    static ArrivalProcess max()
+    {
+        return ArrivalProcess(Kind::Max);
+    }
+
+    static ArrivalProcess constant(double ratePerSecond)
+    {
+        ArrivalProcess p(Kind::Constant);
+        p.rate_ = ratePerSecond;
+        return p;
+    }
+
+    static ArrivalProcess poisson(double ratePerSecond, uint64_t seed = 42)
+    {
+        ArrivalProcess p(Kind::Poisson, seed);
+        p.rate_ = ratePerSecond;
+        return p;
+    }
+
+    static ArrivalProcess onOff(double ratePerSecond, long long onNanos, long long offNanos, uint64_t seed = 42)
+    {
+        ArrivalProcess p(Kind::OnOff, seed);
+        p.rate_ = ratePerSecond;
+        p.onNanos_ = onNanos;
+        p.offNanos_ = offNanos;
+        return p;
+    }
+
+    static ArrivalProcess diurnal(double minRate, double maxRate, long long periodNanos, uint64_t seed = 42)
+    {
+        ArrivalProcess p(Kind::Diurnal, seed);
+        p.rate_ = minRate;
+        p.maxRate_ = maxRate;
+        p.periodNanos_ = periodNanos;
+        return p;
+    }
+
+    static ArrivalProcess replay(std::vector<long long> gapsNanos)
+    {
+        if (gapsNanos.empty())
+        {
+            throw std::invalid_argument("replay trace is empty");
+        }
+        ArrivalProcess p(Kind::Replay);
+        p.trace_ = std::move(gapsNanos);
+        return p;
+    }
+
+    /**
+     * Load whitespace-separated inter-arrival gaps (ns). Lines starting with '#' are ignored.
+     */
+    static ArrivalProcess replayFile(const std::string& path)
+    {
+        std::ifstream in(path);
+        if (!in)
+        {
+            throw std::runtime_error("cannot open arrival trace: " + path);
+        }
+        std::vector<long long> gaps;
+        std::string line;
+        while (std::getline(in, line))
+        {
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+            std::istringstream fields(line);
+            long long gap = 0;
+            while (fields >> gap)
+            {
+                gaps.push_back(gap < 0 ? 0 : gap);
+            }
+        }
+        return replay(std::move(gaps));
+    }
+
+    static ArrivalProcess parse(const std::string& spec)
+    {
+        std::vector<std::string> parts;
+        std::stringstream ss(spec);
+        std::string part;
+        while (std::getline(ss, part, ':'))
+        {
+            parts.push_back(part);
+        }
+        if (parts.empty() || parts[0] == "max")
+        {
+            return max();
+        }
+
+        auto number = [&](size_t i) {
+            if (i >= parts.size())
+            {
+                throw std::invalid_argument("arrival spec '" + spec + "' is missing parameters");
+            }
+            return std::strtod(parts[i].c_str(), nullptr);
+        };
+
+        if (parts[0] == "constant")
+        {
+            return constant(number(1));
+        }
+        if (parts[0] == "poisson")
+        {
+            return poisson(number(1));
+        }
+        if (parts[0] == "onoff")
+        {
+            return onOff(number(1), static_cast<long long>(number(2) * 1e3), static_cast<long long>(number(3) * 1e3));
+        }
+        if (parts[0] == "diurnal")
+        {
+            return diurnal(number(1), number(2), static_cast<long long>(number(3) * 1e6));
+        }
+        if (parts[0] == "replay" && parts.size() > 1)
+        {
+            return replayFile(spec.substr(spec.find(':') + 1));
+        }
+        throw std::invalid_argument("unknown arrival spec: " + spec);
+    }
+
+    /**
+     * Gap in nanoseconds between the previous arrival and the next one.
+     */
+    long long nextGapNanos()
+    {
+        long long gap = 0;
+        switch (kind_)
+        {
+            case Kind::Max:
+                return 0;
+            case Kind::Constant:
+                gap = static_cast<long long>(1e9 / rate_);
+                break;
+            case Kind::Poisson:
+                gap = exponentialGap(rate_);
+                break;
+            case Kind::OnOff:
+                gap = exponentialGap(rate_);
+                if (elapsed_ + gap - windowStart_ >= onNanos_)
+                {
+                    // Burst window over: stay silent, then open the next window.
+                    gap += offNanos_;
+                    windowStart_ = elapsed_ + gap;
+                }
+                break;
+            case Kind::Diurnal:
+            {
+                constexpr double twoPi = 6.283185307179586;
+                double phase = static_cast<double>(elapsed_ % periodNanos_) / static_cast<double>(periodNanos_);
+                double rate = rate_ + (maxRate_ - rate_) * (1.0 - std::cos(twoPi * phase)) / 2.0;
+                gap = exponentialGap(rate);
+                break;
+            }
+            case Kind::Replay:
+                gap = trace_[traceIndex_];
+                traceIndex_ = (traceIndex_ + 1) % trace_.size();
+                break;
+        }
+        elapsed_ += gap;
+        return gap;
+    }
+
+    Kind getKind() const { return kind_; }
+
+    const char* kindName() const
+    {
+        switch (kind_)
+        {
+            case Kind::Constant: return "Constant";
+            case Kind::Poisson: return "Poisson";
+            case Kind::OnOff: return "OnOff";
+            case Kind::Diurnal: return "Diurnal";
+            case Kind::Replay: return "Replay";
+            default: return "Max";
+        }
+    }
+
+private:
+    explicit ArrivalProcess(Kind kind, uint64_t seed = 42) : kind_(kind), rng_(seed) {}
+
+    long long exponentialGap(double ratePerSecond)
+    {
+        if (ratePerSecond <= 0.0)
+        {
+            return 0;
+        }
+        std::exponential_distribution<double> dist(ratePerSecond / 1e9);
+        return static_cast<long long>(dist(rng_));
+    }
+
+    Kind kind_;
+    std::mt19937_64 rng_;
+    double rate_ = 0.0;
+    double maxRate_ = 0.0;
+    long long onNanos_ = 0;
+    long long offNanos_ = 0;
+    long long periodNanos_ = 1;
+    long long elapsed_ = 0;
+    long long windowStart_ = 0;
+    std::vector<long long> trace_;
+    size_t traceIndex_ = 0;
+};
+
+/**
+ * Paces a producer loop against an ArrivalProcess on an absolute schedule.
+ *
+ * awaitNext() spins until the next scheduled arrival and returns its intended
+ * time. If the producer fell behind (ring full, preemption) it returns at once,
+ * so the backlog is published as a burst and latency measured from the
+ * intended time is free of coordinated omission.
+ *
+ * Usage (any topology):
+ *   ArrivalPacer pacer(process);
+ *   pacer.start();
+ *   for (...) {
+ *       long long intended = pacer.awaitNext();
+ *       long seq = ringBuffer.next();
+ *       ringBuffer.get(seq).timestamp = intended;
+ *       ringBuffer.publish(seq);
+ *   }
+ */
+class ArrivalPacer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ArrivalPacer(ArrivalProcess& process) : process_(process) {}
+
+    static long long nowNanos()
+    {
+        return Clock::now().time_since_epoch().count();
+    }
+
+    void start()
+    {
+        next_ = nowNanos();
+    }
+
+    long long awaitNext()
+    {
+        long long gap = process_.nextGapNanos();
+        next_ += gap;
+        if (gap > 0)
+        {
+            while (nowNanos() < next_)
+            {
+                DISRUPTOR_CPU_PAUSE();
+            }
+        }
+        else if (process_.getKind() == ArrivalProcess::Kind::Max)
+        {
+            return nowNanos();
+        }
+        return next_;
+    }
+
+private:
+    ArrivalProcess& process_;
+    long long next_ = 0;
+};
@@ -0,0 +1,570 @@
+// Autotune - 针对给定拓扑与目标指标，在当前主机上搜索 RingBuffer 大小、
+// BatchPublisher 批大小、WorkProcessor workBatchSize、等待策略与线程绑定方式，
+// 输出推荐配置（取代手工修改 perftest_*.cpp 中的常量）
+//
+// 用法: disruptor_autotune [topology] [target] [events] [trialSeconds]
+//   topology: 1to1 | 1to3 | pipeline | 3to1 | workqueue:P:W
+//   target:   throughput | p99:NS@RATE   (例如 p99:20000@1000000 表示 1M/s 下 P99 <= 20us)
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/event_handler.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+#include "disruptor/work_handler.h"
+#include "disruptor/work_processor.h"
+
+#include "arrival_process.h"
+#include "latency_stats.h"
+
+namespace {
+
+struct TunerEvent
+{
+    long value = 0;
+    long long intendedNanos = 0;
+};
+
+long parseLong(const char* text, long fallback)
+{
+    if (!text)
+    {
+        return fallback;
+    }
+    char* end = nullptr;
+    long value = std::strtol(text, &end, 10);
+    if (end == text)
+    {
+        return fallback;
+    }
+    return value;
+}
+
+void pinCurrentThread(int cpu)
+{
+#ifdef __linux__
+    if (cpu < 0)
+    {
+        return;
+    }
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    (void)pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+#else
+    (void)cpu;
+#endif
+}
+
+// ============================================================================
+// Topology / target / configuration
+// ============================================================================
+
+struct Topology
+{
+    enum class Shape
+    {
+        Broadcast,
+        Pipeline,
+        WorkQueue
+    };
+
+    std::string name;
+    Shape shape = Shape::Broadcast;
+    int producers = 1;
+    int consumers = 1;
+};
+
+Topology parseTopology(const std::string& text)
+{
+    Topology t;
+    t.name = text;
+    if (text == "1to3")
+    {
+        t.consumers = 3;
+    }
+    else if (text == "pipeline")
+    {
+        t.shape = Topology::Shape::Pipeline;
+        t.consumers = 3;
+    }
+    else if (text == "3to1")
+    {
+        t.producers = 3;
+    }
+    else if (text.rfind("workqueue", 0) == 0)
+    {
+        t.shape = Topology::Shape::WorkQueue;
+        t.producers = 1;
+        t.consumers = 2;
+        std::stringstream ss(text);
+        std::string part;
+        std::vector<std::string> parts;
+        while (std::getline(ss, part, ':'))
+        {
+            parts.push_back(part);
+        }
+        if (parts.size() > 2)
+        {
+            t.producers = std::max(1, std::atoi(parts[1].c_str()));
+            t.consumers = std::max(1, std::atoi(parts[2].c_str()));
+        }
+    }
+    return t;
+}
+
+struct Target
+{
+    bool latency = false;
+    long long p99Nanos = 0;
+    double rate = 0.0;
+    std::string text;
+};
+
+Target parseTarget(const std::string& text)
+{
+    Target target;
+    target.text = text;
+    if (text.rfind("p99:", 0) == 0)
+    {
+        auto at = text.find('@');
+        target.latency = true;
+        target.p99Nanos = std::atoll(text.substr(4, at - 4).c_str());
+        target.rate = at == std::string::npos ? 1e6 : std::atof(text.substr(at + 1).c_str());
+    }
+    return target;
+}
+
+struct TunerConfig
+{
+    int bufferSize = 1 << 16;
+    int publishBatch = 1;
+    int workBatchSize = 8;
+    std::string wait = "busy";
+    std::string placement = "none";
+};
+
+std::string describe(const TunerConfig& c, const Topology& t)
+{
+    std::ostringstream out;
+    out << "buffer=" << c.bufferSize << " batch=" << c.publishBatch;
+    if (t.shape == Topology::Shape::WorkQueue)
+    {
+        out << " workBatch=" << c.workBatchSize;
+    }
+    out << " wait=" << c.wait << " placement=" << c.placement;
+    return out.str();
+}
+
+std::unique_ptr<disruptor::WaitStrategy> makeWaitStrategy(const std::string& name)
+{
+    if (name == "yield")
+    {
+        return std::make_unique<disruptor::YieldingWaitStrategy>();
+    }
+    if (name == "sleep")
+    {
+        return std::make_unique<disruptor::SleepingWaitStrategy>();
+    }
+    if (name == "blocking")
+    {
+        return std::make_unique<disruptor::BlockingWaitStrategy>();
+    }
+    return std::make_unique<disruptor::BusySpinWaitStrategy>();
+}
+
+/**
+ * CPU for thread index i (producers first, then consumers).
+ * compact: consecutive CPUs; spread: every other CPU (skips likely SMT siblings).
+ */
+int placementCpu(const std::string& placement, int index)
+{
+    int online = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    if (placement == "compact")
+    {
+        return index % online;
+    }
+    if (placement == "spread")
+    {
+        return (index * 2) % online;
+    }
+    return -1;
+}
+
+// ============================================================================
+// Trial runner
+// ============================================================================
+
+class SinkHandler final : public disruptor::EventHandler<TunerEvent>
+{
+public:
+    SinkHandler(long expected, bool recordLatency) : expected_(expected), recordLatency_(recordLatency)
+    {
+        if (recordLatency)
+        {
+            latencies_.reserve(static_cast<size_t>(expected));
+        }
+    }
+
+    void onEvent(TunerEvent& evt, long, bool endOfBatch) override
+    {
+        if (recordLatency_)
+        {
+            latencies_.push_back(ArrivalPacer::nowNanos() - evt.intendedNanos);
+        }
+        if (++count_ >= expected_ && endOfBatch)
+        {
+            done_.store(true, std::memory_order_release);
+        }
+    }
+
+    bool isDone() const { return done_.load(std::memory_order_acquire); }
+    std::vector<long long>& getLatencies() { return latencies_; }
+
+private:
+    long expected_;
+    bool recordLatency_;
+    long count_ = 0;
+    std::vector<long long> latencies_;
+    std::atomic<bool> done_{false};
+};
+
+class SinkWorkHandler final : public disruptor::WorkHandler<TunerEvent>
+{
+public:
+    explicit SinkWorkHandler(bool recordLatency) : recordLatency_(recordLatency) {}
+
+    void onEvent(TunerEvent& evt, long) override
+    {
+        if (recordLatency_)
+        {
+            latencies_.push_back(ArrivalPacer::nowNanos() - evt.intendedNanos);
+        }
+    }
+
+    std::vector<long long>& getLatencies() { return latencies_; }
+
+private:
+    bool recordLatency_;
+    std::vector<long long> latencies_;
+};
+
+struct TrialResult
+{
+    double opsPerSecond = 0.0;
+    LatencyStatistics latency;
+};
+
+TrialResult runTrial(const Topology& topology, const TunerConfig& config, const Target& target, long events)
+{
+    auto waitStrategy = makeWaitStrategy(config.wait);
+    auto ringBuffer = topology.producers > 1 || topology.shape == Topology::Shape::WorkQueue
+        ? disruptor::RingBuffer<TunerEvent>::createMultiProducer([] { return TunerEvent{}; }, config.bufferSize, *waitStrategy)
+        : disruptor::RingBuffer<TunerEvent>::createSingleProducer([] { return TunerEvent{}; }, config.bufferSize, *waitStrategy);
+
+    std::vector<std::unique_ptr<SinkHandler>> handlers;
+    std::vector<std::unique_ptr<disruptor::SequenceBarrier>> barriers;
+    std::vector<std::unique_ptr<disruptor::BatchEventProcessor<TunerEvent>>> processors;
+    std::vector<std::unique_ptr<SinkWorkHandler>> workHandlers;
+    std::vector<std::unique_ptr<disruptor::WorkProcessor<TunerEvent>>> workProcessors;
+    disruptor::Sequence workSequence{disruptor::Sequence::INITIAL_VALUE};
+    std::vector<disruptor::Sequence*> gating;
+
+    if (topology.shape == Topology::Shape::WorkQueue)
+    {
+        for (int i = 0; i < topology.consumers; ++i)
+        {
+            workHandlers.push_back(std::make_unique<SinkWorkHandler>(target.latency));
+            workProcessors.push_back(std::make_unique<disruptor::WorkProcessor<TunerEvent>>(
+                ringBuffer, ringBuffer.newBarrier(), *workHandlers.back(), workSequence, events - 1, config.workBatchSize));
+            gating.push_back(&workProcessors.back()->getSequence());
+        }
+    }
+    else
+    {
+        const bool pipeline = topology.shape == Topology::Shape::Pipeline;
+        for (int i = 0; i < topology.consumers; ++i)
+        {
+            bool sink = !pipeline || i == topology.consumers - 1;
+            handlers.push_back(std::make_unique<SinkHandler>(events, sink && target.latency));
+            std::vector<disruptor::Sequence*> dependents;
+            if (pipeline && i > 0)
+            {
+                dependents.push_back(&processors.back()->getSequence());
+            }
+            barriers.push_back(std::make_unique<disruptor::SequenceBarrier>(ringBuffer.newBarrier(dependents)));
+            processors.push_back(std::make_unique<disruptor::BatchEventProcessor<TunerEvent>>(
+                ringBuffer, *barriers.back(), *handlers.back()));
+            if (sink)
+            {
+                gating.push_back(&processors.back()->getSequence());
+            }
+        }
+    }
+    ringBuffer.addGatingSequences(gating);
+
+    std::vector<std::thread> consumerThreads;
+    for (size_t i = 0; i < processors.size(); ++i)
+    {
+        auto* p = processors[i].get();
+        int cpu = placementCpu(config.placement, topology.producers + static_cast<int>(i));
+        consumerThreads.emplace_back([p, cpu] {
+            pinCurrentThread(cpu);
+            p->run();
+        });
+    }
+    for (size_t i = 0; i < workProcessors.size(); ++i)
+    {
+        auto* p = workProcessors[i].get();
+        int cpu = placementCpu(config.placement, topology.producers + static_cast<int>(i));
+        consumerThreads.emplace_back([p, cpu] {
+            pinCurrentThread(cpu);
+            p->run();
+        });
+    }
+
+    std::atomic<bool> start{false};
+    std::vector<std::thread> producerThreads;
+    for (int p = 0; p < topology.producers; ++p)
+    {
+        producerThreads.emplace_back([&, p] {
+            pinCurrentThread(placementCpu(config.placement, p));
+            long count = events / topology.producers + (p < events % topology.producers ? 1 : 0);
+            auto arrivals = target.latency
+                ? ArrivalProcess::constant(target.rate / topology.producers)
+                : ArrivalProcess::max();
+            ArrivalPacer pacer(arrivals);
+            auto publisher = ringBuffer.createBatchPublisher(config.publishBatch);
+
+            while (!start.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            pacer.start();
+            long produced = 0;
+            while (produced < count)
+            {
+                // Mode 2: claim exactly what will be published so multi-producer
+                // rings never see an unpublished gap.
+                int n = static_cast<int>(std::min<long>(config.publishBatch, count - produced));
+                publisher.beginBatch(n);
+                for (int k = 0; k < n; ++k)
+                {
+                    auto& evt = publisher.getEvent(k);
+                    evt.intendedNanos = pacer.awaitNext();
+                    evt.value = produced + k;
+                }
+                publisher.endBatch();
+                produced += n;
+            }
+        });
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+
+    for (auto& t : producerThreads)
+    {
+        t.join();
+    }
+    for (auto& h : handlers)
+    {
+        while (!h->isDone())
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (size_t i = 0; i < processors.size(); ++i)
+    {
+        processors[i]->halt();
+    }
+    for (auto& t : consumerThreads)
+    {
+        t.join();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    TrialResult result;
+    result.opsPerSecond = events / std::chrono::duration<double>(t1 - t0).count();
+    if (target.latency)
+    {
+        std::vector<long long> all;
+        for (auto& h : handlers)
+        {
+            all.insert(all.end(), h->getLatencies().begin(), h->getLatencies().end());
+        }
+        for (auto& h : workHandlers)
+        {
+            all.insert(all.end(), h->getLatencies().begin(), h->getLatencies().end());
+        }
+        result.latency = computeLatencyStatistics(all);
+    }
+    return result;
+}
+
+/**
+ * Throughput target: higher ops/s wins.
+ * Latency target: meeting the P99 bound beats missing it; then lower P99 wins.
+ */
+bool isBetter(const TrialResult& a, const TrialResult& b, const Target& target)
+{
+    if (!target.latency)
+    {
+        return a.opsPerSecond > b.opsPerSecond;
+    }
+    bool aMeets = a.latency.p99 <= target.p99Nanos;
+    bool bMeets = b.latency.p99 <= target.p99Nanos;
+    if (aMeets != bMeets)
+    {
+        return aMeets;
+    }
+    return a.latency.p99 < b.latency.p99;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string topologyText = (argc > 1 && argv[1]) ? std::string(argv[1]) : std::string("1to1");
+    std::string targetText = (argc > 2 && argv[2]) ? std::string(argv[2]) : std::string("throughput");
+    long events = parseLong(argc > 3 ? argv[3] : nullptr, 2'000'000L);
+    long trialMillis = parseLong(argc > 4 ? argv[4] : nullptr, 500);
+
+    auto topology = parseTopology(topologyText);
+    auto target = parseTarget(targetText);
+    if (target.latency)
+    {
+        // Paced trials: enough events to fill the trial duration at the target rate.
+        events = std::max<long>(1000, static_cast<long>(target.rate * trialMillis / 1000.0));
+    }
+
+    std::cout << "Tool: Autotune\n";
+    std::cout << "Topology: " << topology.name << " (" << topology.producers << "P:" << topology.consumers << "C)\n";
+    std::cout << "Target: " << target.text << "\n";
+    std::cout << "Events per trial: " << events << "\n";
+    std::cout << "CPUs: " << std::thread::hardware_concurrency() << "\n\n";
+
+    const std::vector<int> bufferSizes = {1024, 4096, 16384, 65536};
+    const std::vector<int> publishBatches = {1, 8, 32, 128, 512};
+    const std::vector<int> workBatches = {1, 8, 32};
+    const std::vector<std::string> waits = {"busy", "yield", "sleep", "blocking"};
+    const std::vector<std::string> placements = {"none", "compact", "spread"};
+
+    auto report = [&](const TunerConfig& c, const TrialResult& r) {
+        std::cout << "  " << std::left << std::setw(64) << describe(c, topology) << std::right
+                  << std::scientific << std::setprecision(3) << r.opsPerSecond << " ops/s";
+        if (target.latency)
+        {
+            std::cout << "  p99=" << r.latency.p99 << "ns";
+        }
+        std::cout << std::defaultfloat << "\n";
+    };
+
+    TunerConfig best;
+    TrialResult bestResult = runTrial(topology, best, target, events);
+    report(best, bestResult);
+
+    // Coordinate descent: sweep one dimension at a time, keep improvements,
+    // stop once a full pass changes nothing.
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        bool improved = false;
+        auto tryConfig = [&](const TunerConfig& candidate) {
+            auto r = runTrial(topology, candidate, target, events);
+            report(candidate, r);
+            if (isBetter(r, bestResult, target))
+            {
+                best = candidate;
+                bestResult = r;
+                improved = true;
+            }
+        };
+
+        for (int v : bufferSizes)
+        {
+            if (v != best.bufferSize)
+            {
+                auto c = best;
+                c.bufferSize = v;
+                tryConfig(c);
+            }
+        }
+        for (int v : publishBatches)
+        {
+            if (v != best.publishBatch && v <= best.bufferSize)
+            {
+                auto c = best;
+                c.publishBatch = v;
+                tryConfig(c);
+            }
+        }
+        if (topology.shape == Topology::Shape::WorkQueue)
+        {
+            for (int v : workBatches)
+            {
+                if (v != best.workBatchSize)
+                {
+                    auto c = best;
+                    c.workBatchSize = v;
+                    tryConfig(c);
+                }
+            }
+        }
+        for (const auto& v : waits)
+        {
+            if (v != best.wait)
+            {
+                auto c = best;
+                c.wait = v;
+                tryConfig(c);
+            }
+        }
+        for (const auto& v : placements)
+        {
+            if (v != best.placement)
+            {
+                auto c = best;
+                c.placement = v;
+                tryConfig(c);
+            }
+        }
+
+        if (!improved)
+        {
+            break;
+        }
+    }
+
+    std::cout << "\nRecommended configuration (" << topology.name << ", " << target.text << "):\n";
+    std::cout << "  bufferSize=" << best.bufferSize << "\n";
+    std::cout << "  publishBatch=" << best.publishBatch << "\n";
+    if (topology.shape == Topology::Shape::WorkQueue)
+    {
+        std::cout << "  workBatchSize=" << best.workBatchSize << "\n";
+    }
+    std::cout << "  waitStrategy=" << best.wait << "\n";
+    std::cout << "  placement=" << best.placement << "\n";
+    std::cout << "  throughput(ops/s)=" << bestResult.opsPerSecond << "\n";
+    if (target.latency)
+    {
+        std::cout << "  p99(ns)=" << bestResult.latency.p99
+                  << (bestResult.latency.p99 <= target.p99Nanos ? " (target met)" : " (target NOT met)") << "\n";
+    }
+    return 0;
+}
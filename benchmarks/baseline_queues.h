@@ -0,0 +1,210 @@
+// In-tree reference queues for apples-to-apples comparison with the Disruptor.
+//
+// All three expose the same non-blocking interface:
+//   bool tryPush(const T&)   false when full
+//   bool tryPop(T&)          false when empty
+// so the comparison harness can drive them (and the Disruptor adapter) with
+// identical event types, thread placement and latency methodology.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "disruptor/cache_line_storage.h"
+
+/**
+ * Lamport's classic single-producer/single-consumer ring.
+ * Producer owns tail, consumer owns head; each reads the other's index with acquire.
+ */
+template <typename T>
+class LamportSpscQueue
+{
+public:
+    explicit LamportSpscQueue(size_t capacity)
+        : buffer_(capacity), mask_(capacity - 1)
+    {
+        if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+        {
+            throw std::invalid_argument("capacity must be a power of two");
+        }
+        head_->store(0, std::memory_order_relaxed);
+        tail_->store(0, std::memory_order_relaxed);
+    }
+
+    bool tryPush(const T& value)
+    {
+        size_t tail = tail_->load(std::memory_order_relaxed);
+        if (tail - head_->load(std::memory_order_acquire) == buffer_.size())
+        {
+            return false;
+        }
+        buffer_[tail & mask_] = value;
+        tail_->store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value)
+    {
+        size_t head = head_->load(std::memory_order_relaxed);
+        if (head == tail_->load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        value = buffer_[head & mask_];
+        head_->store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    static constexpr bool MULTI_PRODUCER = false;
+    static constexpr bool MULTI_CONSUMER = false;
+
+private:
+    std::vector<T> buffer_;
+    size_t mask_;
+    disruptor::CachePadded2x<std::atomic<size_t>> head_;
+    disruptor::CachePadded2x<std::atomic<size_t>> tail_;
+};
+
+/**
+ * Dmitry Vyukov's bounded MPMC queue: one sequence number per cell, CAS on the
+ * enqueue/dequeue positions.
+ */
+template <typename T>
+class VyukovMpmcQueue
+{
+public:
+    explicit VyukovMpmcQueue(size_t capacity)
+        : cells_(capacity), mask_(capacity - 1)
+    {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0)
+        {
+            throw std::invalid_argument("capacity must be a power of two >= 2");
+        }
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        enqueuePos_->store(0, std::memory_order_relaxed);
+        dequeuePos_->store(0, std::memory_order_relaxed);
+    }
+
+    bool tryPush(const T& value)
+    {
+        size_t pos = enqueuePos_->load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos_->compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos_->load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value)
+    {
+        size_t pos = dequeuePos_->load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            cell = &cells_[pos & mask_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeuePos_->compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = dequeuePos_->load(std::memory_order_relaxed);
+            }
+        }
+        value = cell->data;
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    static constexpr bool MULTI_PRODUCER = true;
+    static constexpr bool MULTI_CONSUMER = true;
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        T data{};
+    };
+
+    std::vector<Cell> cells_;
+    size_t mask_;
+    disruptor::CachePadded2x<std::atomic<size_t>> enqueuePos_;
+    disruptor::CachePadded2x<std::atomic<size_t>> dequeuePos_;
+};
+
+/**
+ * The textbook baseline: a bounded std::deque behind one mutex.
+ */
+template <typename T>
+class MutexDequeQueue
+{
+public:
+    explicit MutexDequeQueue(size_t capacity) : capacity_(capacity) {}
+
+    bool tryPush(const T& value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.size() >= capacity_)
+        {
+            return false;
+        }
+        queue_.push_back(value);
+        return true;
+    }
+
+    bool tryPop(T& value)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (queue_.empty())
+        {
+            return false;
+        }
+        value = queue_.front();
+        queue_.pop_front();
+        return true;
+    }
+
+    static constexpr bool MULTI_PRODUCER = true;
+    static constexpr bool MULTI_CONSUMER = true;
+
+private:
+    size_t capacity_;
+    std::mutex mutex_;
+    std::deque<T> queue_;
+};
@@ -0,0 +1,454 @@
+// CompareBaselineQueues - 在同一测试框架下比较 Disruptor 与树内参考队列
+// （Lamport SPSC / Vyukov 有界 MPMC / mutex+deque）
+// 所有实现使用相同的事件类型、线程绑定和延迟测量方法
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "disruptor/consumer_barrier.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/sequence.h"
+#include "disruptor/wait_strategy.h"
+#include "disruptor/work_handler.h"
+#include "disruptor/work_processor.h"
+
+#include "arrival_process.h"
+#include "baseline_queues.h"
+#include "hiccup_meter.h"
+#include "latency_stats.h"
+
+namespace {
+
+struct QueueEvent
+{
+    long value = 0;
+    long long publishNanos = 0;
+};
+
+long parseLong(const char* text, long fallback)
+{
+    if (!text)
+    {
+        return fallback;
+    }
+    char* end = nullptr;
+    long value = std::strtol(text, &end, 10);
+    if (end == text)
+    {
+        return fallback;
+    }
+    return value;
+}
+
+void pinCurrentThread(int cpu)
+{
+#ifdef __linux__
+    if (cpu < 0)
+    {
+        return;
+    }
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (rc != 0)
+    {
+        std::cerr << "pthread_setaffinity_np(cpu=" << cpu << ") failed: " << rc << "\n";
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+// ============================================================================
+// Channel adapters: the one interface every implementation is driven through.
+//   void push(const QueueEvent&)         spin until accepted
+//   void consume(int consumer, fn)       deliver events to fn until this consumer is done
+//   void finish(int consumers)           called after all producers returned
+// ============================================================================
+
+/**
+ * Adapter for tryPush/tryPop queues. Consumers stop on a poison event
+ * (value < 0), one per consumer, pushed by finish().
+ */
+template <typename Queue>
+class QueueChannel
+{
+public:
+    QueueChannel(size_t capacity, int, int, long) : queue_(capacity) {}
+
+    void push(const QueueEvent& evt)
+    {
+        while (!queue_.tryPush(evt))
+        {
+            DISRUPTOR_CPU_PAUSE();
+        }
+    }
+
+    template <typename Fn>
+    void consume(int, Fn&& fn)
+    {
+        QueueEvent evt;
+        while (true)
+        {
+            if (queue_.tryPop(evt))
+            {
+                if (evt.value < 0)
+                {
+                    return;
+                }
+                fn(evt);
+            }
+            else
+            {
+                DISRUPTOR_CPU_PAUSE();
+            }
+        }
+    }
+
+    void finish(int consumers)
+    {
+        for (int i = 0; i < consumers; ++i)
+        {
+            push(QueueEvent{-1, 0});
+        }
+    }
+
+private:
+    Queue queue_;
+};
+
+/**
+ * Disruptor adapter. One consumer: raw barrier loop (as in the SPSC comparison).
+ * Several consumers: WorkProcessor work-queue so each message is consumed once,
+ * matching the queue semantics. Both stop at the known last sequence.
+ */
+class DisruptorChannel
+{
+public:
+    DisruptorChannel(size_t capacity, int producers, int consumers, long total)
+        : ringBuffer_(producers > 1
+              ? disruptor::RingBuffer<QueueEvent>::createMultiProducer(
+                    [] { return QueueEvent{}; }, static_cast<int>(capacity), waitStrategy_)
+              : disruptor::RingBuffer<QueueEvent>::createSingleProducer(
+                    [] { return QueueEvent{}; }, static_cast<int>(capacity), waitStrategy_)),
+          lastSequence_(total - 1)
+    {
+        std::vector<disruptor::Sequence*> gating;
+        if (consumers == 1)
+        {
+            barrier_ = std::make_unique<disruptor::SequenceBarrier>(ringBuffer_.newBarrier());
+            gating.push_back(&consumerSequence_);
+        }
+        else
+        {
+            for (int i = 0; i < consumers; ++i)
+            {
+                handlers_.push_back(std::make_unique<CallbackWorkHandler>());
+                processors_.push_back(std::make_unique<disruptor::WorkProcessor<QueueEvent>>(
+                    ringBuffer_, ringBuffer_.newBarrier(), *handlers_.back(), workSequence_, lastSequence_, 8));
+                gating.push_back(&processors_.back()->getSequence());
+            }
+        }
+        ringBuffer_.addGatingSequences(gating);
+    }
+
+    void push(const QueueEvent& evt)
+    {
+        long seq = ringBuffer_.next();
+        ringBuffer_.get(seq) = evt;
+        ringBuffer_.publish(seq);
+    }
+
+    template <typename Fn>
+    void consume(int consumer, Fn&& fn)
+    {
+        if (barrier_)
+        {
+            long next = 0;
+            while (next <= lastSequence_)
+            {
+                long available = std::min(barrier_->waitFor(next), lastSequence_);
+                for (; next <= available; ++next)
+                {
+                    fn(ringBuffer_.get(next));
+                }
+                consumerSequence_.set(available);
+            }
+            return;
+        }
+
+        auto& handler = *handlers_[static_cast<size_t>(consumer)];
+        handler.callback = [&fn](QueueEvent& evt) { fn(evt); };
+        processors_[static_cast<size_t>(consumer)]->run();
+    }
+
+    void finish(int) {}
+
+private:
+    struct CallbackWorkHandler final : public disruptor::WorkHandler<QueueEvent>
+    {
+        void onEvent(QueueEvent& evt, long) override
+        {
+            callback(evt);
+        }
+
+        std::function<void(QueueEvent&)> callback;
+    };
+
+    disruptor::BusySpinWaitStrategy waitStrategy_;
+    disruptor::RingBuffer<QueueEvent> ringBuffer_;
+    long lastSequence_;
+    disruptor::Sequence consumerSequence_{disruptor::Sequence::INITIAL_VALUE};
+    std::unique_ptr<disruptor::SequenceBarrier> barrier_;
+    disruptor::Sequence workSequence_{disruptor::Sequence::INITIAL_VALUE};
+    std::vector<std::unique_ptr<CallbackWorkHandler>> handlers_;
+    std::vector<std::unique_ptr<disruptor::WorkProcessor<QueueEvent>>> processors_;
+};
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+struct RunResult
+{
+    double opsPerSecond = 0.0;
+    long long sum = 0;
+    LatencyStatistics latency;
+};
+
+/**
+ * intervalNanos == 0: saturating throughput run.
+ * intervalNanos > 0:  each producer paced at one event per interval; latency
+ *                     measured from the intended publish time for every event.
+ */
+template <typename Channel>
+RunResult runChannel(int producers, int consumers, long total, size_t capacity, const std::vector<int>& cpus,
+                     long intervalNanos)
+{
+    Channel channel(capacity, producers, consumers, total);
+    const bool measureLatency = intervalNanos > 0;
+
+    std::atomic<int> ready{0};
+    std::atomic<bool> start{false};
+    std::vector<long long> sums(static_cast<size_t>(consumers), 0);
+    std::vector<std::vector<long long>> latencies(static_cast<size_t>(consumers));
+
+    auto cpuFor = [&](int index) {
+        return cpus.empty() ? -1 : cpus[static_cast<size_t>(index) % cpus.size()];
+    };
+
+    std::vector<std::thread> consumerThreads;
+    for (int c = 0; c < consumers; ++c)
+    {
+        consumerThreads.emplace_back([&, c] {
+            pinCurrentThread(cpuFor(c));
+            auto& lat = latencies[static_cast<size_t>(c)];
+            if (measureLatency)
+            {
+                lat.reserve(static_cast<size_t>(total / consumers + 1));
+            }
+            ready.fetch_add(1, std::memory_order_release);
+            while (!start.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            long long localSum = 0;
+            channel.consume(c, [&](const QueueEvent& evt) {
+                localSum += evt.value;
+                if (measureLatency)
+                {
+                    lat.push_back(ArrivalPacer::nowNanos() - evt.publishNanos);
+                }
+            });
+            sums[static_cast<size_t>(c)] = localSum;
+        });
+    }
+
+    std::vector<std::thread> producerThreads;
+    for (int p = 0; p < producers; ++p)
+    {
+        producerThreads.emplace_back([&, p] {
+            pinCurrentThread(cpuFor(consumers + p));
+            long first = total / producers * p + std::min<long>(p, total % producers);
+            long count = total / producers + (p < total % producers ? 1 : 0);
+
+            auto arrivals = measureLatency ? ArrivalProcess::constant(1e9 / intervalNanos) : ArrivalProcess::max();
+            ArrivalPacer pacer(arrivals);
+
+            ready.fetch_add(1, std::memory_order_release);
+            while (!start.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+
+            pacer.start();
+            for (long i = 0; i < count; ++i)
+            {
+                QueueEvent evt;
+                evt.value = first + i;
+                evt.publishNanos = measureLatency ? pacer.awaitNext() : 0;
+                channel.push(evt);
+            }
+        });
+    }
+
+    while (ready.load(std::memory_order_acquire) < producers + consumers)
+    {
+        std::this_thread::yield();
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+
+    for (auto& t : producerThreads)
+    {
+        t.join();
+    }
+    channel.finish(consumers);
+    for (auto& t : consumerThreads)
+    {
+        t.join();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    RunResult r;
+    r.opsPerSecond = static_cast<double>(total) / std::chrono::duration<double>(t1 - t0).count();
+    for (auto s : sums)
+    {
+        r.sum += s;
+    }
+    if (measureLatency)
+    {
+        std::vector<long long> all;
+        for (auto& l : latencies)
+        {
+            all.insert(all.end(), l.begin(), l.end());
+        }
+        r.latency = computeLatencyStatistics(all);
+    }
+    return r;
+}
+
+/**
+ * The hiccup meter runs beside the latency run only; its samples are reported
+ * on the row and appended to hiccups for the summary after the table.
+ */
+template <typename Channel>
+void runAndReport(const char* name, int producers, int consumers, long total, size_t capacity,
+                  const std::vector<int>& cpus, long latencyEvents, long intervalNanos, HiccupMeter& hiccupMeter,
+                  std::vector<long long>& hiccups)
+{
+    // Warmup
+    (void)runChannel<Channel>(producers, consumers, std::min<long>(200'000L, total), capacity, cpus, 0);
+
+    auto tput = runChannel<Channel>(producers, consumers, total, capacity, cpus, 0);
+    hiccupMeter.start();
+    auto lat = runChannel<Channel>(producers, consumers, latencyEvents, capacity, cpus, intervalNanos);
+    hiccupMeter.stop();
+    hiccups.insert(hiccups.end(), hiccupMeter.getHiccups().begin(), hiccupMeter.getHiccups().end());
+    auto hiccup = computeLatencyStatistics(hiccupMeter.getHiccups());
+
+    long long expectedSum = (static_cast<long long>(total - 1) * total) / 2;
+    std::cout << std::left << std::setw(20) << name << std::right
+              << std::scientific << std::setprecision(3) << std::setw(14) << tput.opsPerSecond
+              << std::setw(10) << lat.latency.p50
+              << std::setw(10) << lat.latency.p99
+              << std::setw(12) << lat.latency.p999
+              << std::setw(12) << lat.latency.max
+              << std::setw(12) << hiccup.p99
+              << std::setw(12) << hiccup.max
+              << "  " << (tput.sum == expectedSum ? "ok" : "SUM MISMATCH") << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string topology = (argc > 1 && argv[1]) ? std::string(argv[1]) : std::string("spsc");
+    long total = parseLong(argc > 2 ? argv[2] : nullptr, 10'000'000L);
+    int capacity = static_cast<int>(parseLong(argc > 3 ? argv[3] : nullptr, 1 << 16));
+    int producers = static_cast<int>(parseLong(argc > 4 ? argv[4] : nullptr, topology == "spsc" ? 1 : 3));
+    int consumers = static_cast<int>(parseLong(argc > 5 ? argv[5] : nullptr, topology == "mpmc" ? 3 : 1));
+    int baseCpu = static_cast<int>(parseLong(argc > 6 ? argv[6] : nullptr, 0));
+    long latencyEvents = parseLong(argc > 7 ? argv[7] : nullptr, 200'000L);
+    long intervalNanos = parseLong(argc > 8 ? argv[8] : nullptr, 2'000L);
+    // Hiccup meter resolution (us) during the latency runs.
+    long hiccupResolutionUs = std::max(1L, parseLong(argc > 9 ? argv[9] : nullptr, 1000));
+
+    if (topology == "spsc")
+    {
+        producers = 1;
+        consumers = 1;
+    }
+    else if (topology == "mpsc")
+    {
+        consumers = 1;
+    }
+
+    // Identical placement for every implementation: consumers first, then producers,
+    // on consecutive CPUs starting at baseCpu. baseCpu < 0 leaves threads unpinned.
+    std::vector<int> cpus;
+    if (baseCpu >= 0)
+    {
+        int online = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (int i = 0; i < producers + consumers; ++i)
+        {
+            cpus.push_back((baseCpu + i) % online);
+        }
+    }
+
+    std::cout << "Benchmark: Baseline queues (" << topology << ", each message consumed once)\n";
+    std::cout << "Producers: " << producers << "\n";
+    std::cout << "Consumers: " << consumers << "\n";
+    std::cout << "Messages: " << total << "\n";
+    std::cout << "Capacity: " << capacity << "\n";
+    std::cout << "Latency run: " << latencyEvents << " msgs, each producer paced at " << intervalNanos << "ns\n";
+    std::cout << "Pinning: " << (cpus.empty() ? std::string("none") : "consecutive from CPU" + std::to_string(baseCpu)) << "\n\n";
+
+    std::cout << std::left << std::setw(20) << "Impl" << std::right
+              << std::setw(14) << "Tput(msg/s)"
+              << std::setw(10) << "P50(ns)"
+              << std::setw(10) << "P99(ns)"
+              << std::setw(12) << "P99.9(ns)"
+              << std::setw(12) << "Max(ns)"
+              << std::setw(12) << "HicP99(ns)"
+              << std::setw(12) << "HicMax(ns)" << "\n";
+
+    HiccupMeter hiccupMeter{std::chrono::microseconds(hiccupResolutionUs)};
+    std::vector<long long> hiccups;
+
+    size_t cap = static_cast<size_t>(capacity);
+    runAndReport<DisruptorChannel>("Disruptor-CPP", producers, consumers, total, cap, cpus, latencyEvents, intervalNanos,
+                                   hiccupMeter, hiccups);
+    if (producers == 1 && consumers == 1)
+    {
+        runAndReport<QueueChannel<LamportSpscQueue<QueueEvent>>>(
+            "Lamport SPSC", producers, consumers, total, cap, cpus, latencyEvents, intervalNanos, hiccupMeter, hiccups);
+    }
+    runAndReport<QueueChannel<VyukovMpmcQueue<QueueEvent>>>(
+        "Vyukov MPMC", producers, consumers, total, cap, cpus, latencyEvents, intervalNanos, hiccupMeter, hiccups);
+    runAndReport<QueueChannel<MutexDequeQueue<QueueEvent>>>(
+        "Mutex+deque", producers, consumers, total, cap, cpus, latencyEvents, intervalNanos, hiccupMeter, hiccups);
+
+    std::cout << "\nHiccupMeter: " << HiccupMeter::modeName(hiccupMeter.getMode()) << ", resolution "
+              << hiccupResolutionUs << "us, all latency runs\n";
+    printLatencyStatistics(std::cout, "Hiccup Statistics", hiccups);
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+// HiccupMeter - 独立运行的平台抖动测量工具（类似 jHiccup）
+// 在部署前用于评估主机：记录中断、SMI、调频等造成的停顿
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hiccup_meter.h"
+#include "latency_stats.h"
+
+long parseLong(const char* text, long fallback)
+{
+    if (!text)
+    {
+        return fallback;
+    }
+    char* end = nullptr;
+    long value = std::strtol(text, &end, 10);
+    if (end == text)
+    {
+        return fallback;
+    }
+    return value;
+}
+
+int main(int argc, char** argv)
+{
+    long seconds = parseLong(argc > 1 ? argv[1] : nullptr, 10);
+    long resolutionUs = parseLong(argc > 2 ? argv[2] : nullptr, 1000);
+    std::string mode = (argc > 3 && argv[3]) ? std::string(argv[3]) : std::string("sleep");
+    int cpu = static_cast<int>(parseLong(argc > 4 ? argv[4] : nullptr, -1));
+
+    if (resolutionUs < 1)
+    {
+        resolutionUs = 1;
+    }
+
+    HiccupMeter meter(std::chrono::microseconds(resolutionUs),
+        mode == "spin" ? HiccupMeter::Mode::Spin : HiccupMeter::Mode::Sleep, cpu);
+
+    meter.start();
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    meter.stop();
+
+    auto& hiccups = meter.getHiccups();
+
+    long over10us = 0;
+    long over100us = 0;
+    long over1ms = 0;
+    for (auto h : hiccups)
+    {
+        over10us += h > 10'000 ? 1 : 0;
+        over100us += h > 100'000 ? 1 : 0;
+        over1ms += h > 1'000'000 ? 1 : 0;
+    }
+
+    std::cout << "Tool: HiccupMeter\n";
+    std::cout << "Mode: " << HiccupMeter::modeName(meter.getMode()) << "\n";
+    std::cout << "Resolution(us): " << resolutionUs << "\n";
+    std::cout << "CPU: " << (cpu >= 0 ? std::to_string(cpu) : std::string("unpinned")) << "\n";
+    std::cout << "Duration(s): " << seconds << "\n";
+    std::cout << "Samples: " << hiccups.size() << "\n";
+    std::cout << "Intervals > 10us: " << over10us << "\n";
+    std::cout << "Intervals > 100us: " << over100us << "\n";
+    std::cout << "Intervals > 1ms: " << over1ms << "\n";
+
+    printLatencyStatistics(std::cout, "Hiccup Statistics", hiccups);
+    return 0;
+}
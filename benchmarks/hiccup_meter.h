@@ -0,0 +1,165 @@
+// HiccupMeter - jHiccup-style platform jitter meter.
+//
+// Runs a thread that does nothing but wait for fixed intervals and records how
+// late it observes the end of each interval. Any delay it sees was caused by the
+// platform (interrupts, SMIs, frequency changes, scheduler preemption), not by
+// the ring, so running it beside a latency benchmark separates the two.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "latency_stats.h"
+
+class HiccupMeter
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Sleep: sleep for the resolution and record the overshoot (jHiccup default,
+     *        negligible CPU cost, can run beside any benchmark).
+     * Spin:  busy-read the clock and record the longest gap seen in each
+     *        resolution interval. Catches sub-millisecond stalls but burns a core.
+     */
+    enum class Mode
+    {
+        Sleep,
+        Spin
+    };
+
+    explicit HiccupMeter(std::chrono::nanoseconds resolution = std::chrono::milliseconds(1),
+                         Mode mode = Mode::Sleep, int cpu = -1)
+        : resolution_(resolution), mode_(mode), cpu_(cpu)
+    {
+    }
+
+    ~HiccupMeter()
+    {
+        stop();
+    }
+
+    HiccupMeter(const HiccupMeter&) = delete;
+    HiccupMeter& operator=(const HiccupMeter&) = delete;
+
+    void start()
+    {
+        if (thread_.joinable())
+        {
+            return;
+        }
+        hiccups_.clear();
+        running_.store(true, std::memory_order_release);
+        thread_ = std::thread([this] { run(); });
+    }
+
+    void stop()
+    {
+        running_.store(false, std::memory_order_release);
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    }
+
+    /**
+     * One sample per resolution interval, in nanoseconds. Only valid after stop().
+     */
+    std::vector<long long>& getHiccups() { return hiccups_; }
+
+    std::chrono::nanoseconds getResolution() const { return resolution_; }
+    Mode getMode() const { return mode_; }
+
+    static const char* modeName(Mode mode)
+    {
+        return mode == Mode::Spin ? "Spin" : "Sleep";
+    }
+
+private:
+    void run()
+    {
+#ifdef __linux__
+        if (cpu_ >= 0)
+        {
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET(cpu_, &cpuset);
+            int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+            if (rc != 0)
+            {
+                std::cerr << "HiccupMeter: pthread_setaffinity_np(cpu=" << cpu_ << ") failed: " << rc << "\n";
+            }
+        }
+#endif
+        hiccups_.reserve(4096);
+        if (mode_ == Mode::Spin)
+        {
+            runSpin();
+        }
+        else
+        {
+            runSleep();
+        }
+    }
+
+    void runSleep()
+    {
+        while (running_.load(std::memory_order_acquire))
+        {
+            auto before = Clock::now();
+            std::this_thread::sleep_for(resolution_);
+            auto after = Clock::now();
+            long long overshoot = (after - before - resolution_).count();
+            hiccups_.push_back(overshoot > 0 ? overshoot : 0);
+        }
+    }
+
+    void runSpin()
+    {
+        const long long interval = resolution_.count();
+        while (running_.load(std::memory_order_acquire))
+        {
+            auto intervalStart = Clock::now();
+            auto last = intervalStart;
+            long long maxGap = 0;
+            while ((last - intervalStart).count() < interval)
+            {
+                auto now = Clock::now();
+                long long gap = (now - last).count();
+                if (gap > maxGap)
+                {
+                    maxGap = gap;
+                }
+                last = now;
+            }
+            hiccups_.push_back(maxGap);
+        }
+    }
+
+    std::chrono::nanoseconds resolution_;
+    Mode mode_;
+    int cpu_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    std::vector<long long> hiccups_;
+};
+
+/**
+ * Print the meter's samples in the latency report format, to sit beside a
+ * benchmark's own latency results. Call after stop().
+ */
+inline void printHiccupStatistics(std::ostream& out, HiccupMeter& meter)
+{
+    out << "\nHiccupMeter: " << HiccupMeter::modeName(meter.getMode()) << ", resolution "
+        << std::chrono::duration_cast<std::chrono::microseconds>(meter.getResolution()).count() << "us\n";
+    printLatencyStatistics(out, "Hiccup Statistics", meter.getHiccups());
+}
@@ -0,0 +1,187 @@
+// InterferenceLoad - configurable noisy-neighbour threads for benchmarks.
+//
+// Production hosts are never as quiet as an isolated perftest run. These loads
+// reproduce the common kinds of co-scheduled interference so a pipeline can be
+// measured while they run next to it:
+//   MemoryBandwidth: streaming copies over a buffer much larger than the LLC
+//   CacheThrash:     random cache-line writes over an LLC-sized buffer
+//   Spin:            pure CPU burners (oversubscription when pinned to the
+//                    same cores as the pipeline)
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+class InterferenceLoad
+{
+public:
+    enum class Kind
+    {
+        None,
+        MemoryBandwidth,
+        CacheThrash,
+        Spin
+    };
+
+    static Kind parseKind(const std::string& name)
+    {
+        if (name == "membw" || name == "memory")
+        {
+            return Kind::MemoryBandwidth;
+        }
+        if (name == "cache")
+        {
+            return Kind::CacheThrash;
+        }
+        if (name == "spin" || name == "oversubscribe")
+        {
+            return Kind::Spin;
+        }
+        return Kind::None;
+    }
+
+    static const char* kindName(Kind kind)
+    {
+        switch (kind)
+        {
+            case Kind::MemoryBandwidth: return "MemoryBandwidth";
+            case Kind::CacheThrash: return "CacheThrash";
+            case Kind::Spin: return "Spin";
+            default: return "None";
+        }
+    }
+
+    /**
+     * @param kind Interference type
+     * @param threads Number of interfering threads
+     * @param bytesPerThread Working-set size of each memory/cache thread
+     * @param cpus CPUs to pin threads to (round-robin); empty = unpinned
+     */
+    InterferenceLoad(Kind kind, int threads, size_t bytesPerThread, std::vector<int> cpus = {})
+        : kind_(kind), threads_(threads), bytesPerThread_(bytesPerThread), cpus_(std::move(cpus))
+    {
+    }
+
+    ~InterferenceLoad()
+    {
+        stop();
+    }
+
+    InterferenceLoad(const InterferenceLoad&) = delete;
+    InterferenceLoad& operator=(const InterferenceLoad&) = delete;
+
+    void start()
+    {
+        if (kind_ == Kind::None || !workers_.empty())
+        {
+            return;
+        }
+        running_.store(true, std::memory_order_release);
+        for (int i = 0; i < threads_; ++i)
+        {
+            int cpu = cpus_.empty() ? -1 : cpus_[static_cast<size_t>(i) % cpus_.size()];
+            workers_.emplace_back([this, cpu] { run(cpu); });
+        }
+    }
+
+    void stop()
+    {
+        running_.store(false, std::memory_order_release);
+        for (auto& t : workers_)
+        {
+            if (t.joinable())
+            {
+                t.join();
+            }
+        }
+        workers_.clear();
+    }
+
+    Kind getKind() const { return kind_; }
+
+private:
+    void run(int cpu)
+    {
+#ifdef __linux__
+        if (cpu >= 0)
+        {
+            cpu_set_t cpuset;
+            CPU_ZERO(&cpuset);
+            CPU_SET(cpu, &cpuset);
+            int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+            if (rc != 0)
+            {
+                std::cerr << "InterferenceLoad: pthread_setaffinity_np(cpu=" << cpu << ") failed: " << rc << "\n";
+            }
+        }
+#endif
+        switch (kind_)
+        {
+            case Kind::MemoryBandwidth: runMemoryBandwidth(); break;
+            case Kind::CacheThrash: runCacheThrash(); break;
+            case Kind::Spin: runSpin(); break;
+            default: break;
+        }
+    }
+
+    void runMemoryBandwidth()
+    {
+        size_t half = bytesPerThread_ / 2;
+        std::vector<char> buffer(half * 2, 1);
+        char* src = buffer.data();
+        char* dst = buffer.data() + half;
+        while (running_.load(std::memory_order_relaxed))
+        {
+            std::memcpy(dst, src, half);
+            std::swap(src, dst);
+        }
+    }
+
+    void runCacheThrash()
+    {
+        constexpr size_t line = 64;
+        size_t lines = bytesPerThread_ / line;
+        if (lines == 0)
+        {
+            return;
+        }
+        std::vector<char> buffer(lines * line, 0);
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        while (running_.load(std::memory_order_relaxed))
+        {
+            for (int i = 0; i < 1024; ++i)
+            {
+                // LCG step: defeats the hardware prefetcher.
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                buffer[(state >> 16) % lines * line] += 1;
+            }
+        }
+    }
+
+    void runSpin()
+    {
+        volatile uint64_t counter = 0;
+        while (running_.load(std::memory_order_relaxed))
+        {
+            counter = counter + 1;
+        }
+    }
+
+    Kind kind_;
+    int threads_;
+    size_t bytesPerThread_;
+    std::vector<int> cpus_;
+    std::atomic<bool> running_{false};
+    std::vector<std::thread> workers_;
+};
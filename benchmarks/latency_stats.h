@@ -0,0 +1,75 @@
+// Shared percentile report used by the latency benchmarks and the hiccup meter,
+// so ring latency and platform stalls print in the same format.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+struct LatencyStatistics
+{
+    size_t count = 0;
+    long long min = 0;
+    double avg = 0.0;
+    long long p50 = 0;
+    long long p90 = 0;
+    long long p99 = 0;
+    long long p999 = 0;
+    long long max = 0;
+};
+
+/**
+ * Summarize samples (sorted in place). Percentiles use the same
+ * index-into-sorted-array method as the original ping-pong test.
+ */
+inline LatencyStatistics computeLatencyStatistics(std::vector<long long>& samples)
+{
+    LatencyStatistics stats;
+    if (samples.empty())
+    {
+        return stats;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    long long sum = 0;
+    for (auto sample : samples)
+    {
+        sum += sample;
+    }
+
+    stats.count = samples.size();
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.avg = static_cast<double>(sum) / samples.size();
+    stats.p50 = samples[samples.size() / 2];
+    stats.p90 = samples[static_cast<size_t>(samples.size() * 0.9)];
+    stats.p99 = samples[static_cast<size_t>(samples.size() * 0.99)];
+    stats.p999 = samples[static_cast<size_t>(samples.size() * 0.999)];
+    return stats;
+}
+
+inline void printLatencyStatistics(std::ostream& out, const std::string& title, const LatencyStatistics& stats)
+{
+    out << "\n" << title << " (ns):\n";
+    if (stats.count == 0)
+    {
+        out << "  (no samples)\n";
+        return;
+    }
+    out << "  Min:    " << stats.min << "\n";
+    out << "  Avg:    " << std::fixed << std::setprecision(2) << stats.avg << "\n";
+    out << "  P50:    " << stats.p50 << "\n";
+    out << "  P90:    " << stats.p90 << "\n";
+    out << "  P99:    " << stats.p99 << "\n";
+    out << "  P99.9:  " << stats.p999 << "\n";
+    out << "  Max:    " << stats.max << "\n";
+}
+
+inline void printLatencyStatistics(std::ostream& out, const std::string& title, std::vector<long long>& samples)
+{
+    printLatencyStatistics(out, title, computeLatencyStatistics(samples));
+}
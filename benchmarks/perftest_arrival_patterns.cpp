@@ -0,0 +1,230 @@
+// ArrivalPatternTest - 测试不同到达过程（Poisson / 突发 / 日内波动 / 轨迹回放）下的
+// 吞吐、延迟与批处理效果
+// 拓扑：1to1 (1P:1C) / 1to3 (1P:3C 广播) / pipeline (1P -> C1 -> C2 -> C3)
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/event_handler.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+#include "arrival_process.h"
+#include "hiccup_meter.h"
+#include "latency_stats.h"
+
+struct ArrivalEvent
+{
+    long value = 0;
+    long long intendedNanos = 0;
+};
+
+/**
+ * Records batch sizes (from endOfBatch) and, for sink stages, latency measured
+ * from the arrival's intended time.
+ */
+class ArrivalHandler final : public disruptor::EventHandler<ArrivalEvent>
+{
+public:
+    ArrivalHandler(long expectedCount, bool recordLatency)
+        : expectedCount_(expectedCount), recordLatency_(recordLatency)
+    {
+        if (recordLatency)
+        {
+            latencies_.reserve(static_cast<size_t>(expectedCount));
+        }
+    }
+
+    void onEvent(ArrivalEvent& evt, long, bool endOfBatch) override
+    {
+        if (recordLatency_)
+        {
+            latencies_.push_back(ArrivalPacer::nowNanos() - evt.intendedNanos);
+        }
+        ++count_;
+        ++currentBatch_;
+        if (endOfBatch)
+        {
+            ++batches_;
+            maxBatch_ = std::max(maxBatch_, currentBatch_);
+            currentBatch_ = 0;
+            if (count_ >= expectedCount_)
+            {
+                done_.store(true, std::memory_order_release);
+            }
+        }
+    }
+
+    bool isDone() const { return done_.load(std::memory_order_acquire); }
+    long getCount() const { return count_; }
+    long getBatches() const { return batches_; }
+    long getMaxBatch() const { return maxBatch_; }
+    std::vector<long long>& getLatencies() { return latencies_; }
+
+private:
+    long expectedCount_;
+    bool recordLatency_;
+    long count_ = 0;
+    long currentBatch_ = 0;
+    long batches_ = 0;
+    long maxBatch_ = 0;
+    std::vector<long long> latencies_;
+    std::atomic<bool> done_{false};
+};
+
+long parseLong(const char* text, long fallback)
+{
+    if (!text)
+    {
+        return fallback;
+    }
+    char* end = nullptr;
+    long value = std::strtol(text, &end, 10);
+    if (end == text)
+    {
+        return fallback;
+    }
+    return value;
+}
+
+int main(int argc, char** argv)
+{
+    long iterations = parseLong(argc > 1 ? argv[1] : nullptr, 1'000'000L);
+    std::string spec = (argc > 2 && argv[2]) ? std::string(argv[2]) : std::string("poisson:1000000");
+    std::string topology = (argc > 3 && argv[3]) ? std::string(argv[3]) : std::string("1to1");
+    int bufferSize = static_cast<int>(parseLong(argc > 4 ? argv[4] : nullptr, 1 << 16));
+    std::string wait = (argc > 5 && argv[5]) ? std::string(argv[5]) : std::string("busy");
+    // 平台抖动测量分辨率（微秒），0 表示关闭
+    long hiccupResolutionUs = parseLong(argc > 6 ? argv[6] : nullptr, 1000);
+
+    auto arrivals = ArrivalProcess::parse(spec);
+
+    disruptor::BusySpinWaitStrategy busy;
+    disruptor::YieldingWaitStrategy yielding;
+    disruptor::WaitStrategy& waitStrategy = (wait == "yield" || wait == "yielding")
+        ? static_cast<disruptor::WaitStrategy&>(yielding)
+        : static_cast<disruptor::WaitStrategy&>(busy);
+
+    auto ringBuffer = disruptor::RingBuffer<ArrivalEvent>::createSingleProducer(
+        [] { return ArrivalEvent{}; }, bufferSize, waitStrategy);
+
+    const bool pipeline = topology == "pipeline";
+    const int numConsumers = topology == "1to1" ? 1 : 3;
+
+    std::vector<std::unique_ptr<ArrivalHandler>> handlers;
+    std::vector<std::unique_ptr<disruptor::SequenceBarrier>> barriers;
+    std::vector<std::unique_ptr<disruptor::BatchEventProcessor<ArrivalEvent>>> processors;
+    std::vector<disruptor::Sequence*> gatingSequences;
+
+    for (int i = 0; i < numConsumers; ++i)
+    {
+        // Broadcast: every consumer is a sink. Pipeline: only the last stage is.
+        bool sink = !pipeline || i == numConsumers - 1;
+        handlers.push_back(std::make_unique<ArrivalHandler>(iterations, sink));
+
+        std::vector<disruptor::Sequence*> dependents;
+        if (pipeline && i > 0)
+        {
+            dependents.push_back(&processors.back()->getSequence());
+        }
+        barriers.push_back(std::make_unique<disruptor::SequenceBarrier>(ringBuffer.newBarrier(dependents)));
+        processors.push_back(std::make_unique<disruptor::BatchEventProcessor<ArrivalEvent>>(
+            ringBuffer, *barriers.back(), *handlers.back()));
+
+        if (!pipeline || i == numConsumers - 1)
+        {
+            gatingSequences.push_back(&processors.back()->getSequence());
+        }
+    }
+    ringBuffer.addGatingSequences(gatingSequences);
+
+    std::vector<std::thread> consumerThreads;
+    for (auto& processor : processors)
+    {
+        auto* p = processor.get();
+        consumerThreads.emplace_back([p] { p->run(); });
+    }
+
+    // 与测试并行运行抖动测量线程，区分平台停顿与 RingBuffer 延迟
+    HiccupMeter hiccupMeter(std::chrono::microseconds(hiccupResolutionUs > 0 ? hiccupResolutionUs : 1));
+    if (hiccupResolutionUs > 0)
+    {
+        hiccupMeter.start();
+    }
+
+    ArrivalPacer pacer(arrivals);
+    auto start = std::chrono::steady_clock::now();
+    pacer.start();
+    for (long i = 0; i < iterations; ++i)
+    {
+        long long intended = pacer.awaitNext();
+        long seq = ringBuffer.next();
+        auto& evt = ringBuffer.get(seq);
+        evt.value = i;
+        evt.intendedNanos = intended;
+        ringBuffer.publish(seq);
+    }
+
+    for (auto& handler : handlers)
+    {
+        while (!handler->isDone())
+        {
+            std::this_thread::yield();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    hiccupMeter.stop();
+
+    for (auto& processor : processors)
+    {
+        processor->halt();
+    }
+    for (auto& thread : consumerThreads)
+    {
+        thread.join();
+    }
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "PerfTest: ArrivalPatterns\n";
+    std::cout << "Arrivals: " << arrivals.kindName() << " (" << spec << ")\n";
+    std::cout << "Topology: " << topology << "\n";
+    std::cout << "WaitStrategy: " << ((wait == "yield" || wait == "yielding") ? "Yielding" : "BusySpin") << "\n";
+    std::cout << "BufferSize: " << bufferSize << "\n";
+    std::cout << "Iterations: " << iterations << "\n";
+    std::cout << "Time(s): " << seconds << "\n";
+    std::cout << "Throughput(ops/s): " << iterations / seconds << "\n";
+
+    std::cout << "\nBatching:\n";
+    for (size_t i = 0; i < handlers.size(); ++i)
+    {
+        auto& h = *handlers[i];
+        double avgBatch = h.getBatches() > 0 ? static_cast<double>(h.getCount()) / h.getBatches() : 0.0;
+        std::cout << "  Consumer " << i << ": batches " << h.getBatches()
+                  << ", avg " << std::fixed << std::setprecision(2) << avgBatch
+                  << ", max " << h.getMaxBatch() << "\n";
+    }
+
+    std::vector<long long> latencies;
+    for (auto& handler : handlers)
+    {
+        auto& l = handler->getLatencies();
+        latencies.insert(latencies.end(), l.begin(), l.end());
+    }
+    printLatencyStatistics(std::cout, "Latency Statistics (from intended arrival)", latencies);
+
+    if (hiccupResolutionUs > 0)
+    {
+        printHiccupStatistics(std::cout, hiccupMeter);
+    }
+
+    return 0;
+}
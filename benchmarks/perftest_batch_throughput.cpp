@@ -6,6 +6,7 @@
  * 2. BatchPublisher Mode 1: Fixed batch size (simple API)
  * 3. BatchPublisher Mode 2: Dynamic batch (Java-style API)
  * 4. Direct RingBuffer batch (raw API)
+ * 5. AdaptiveBatchPublisher (self-tuning batch size)
  */
 
 #include <atomic>
@@ -14,6 +15,7 @@
 #include <thread>
 #include <vector>
 
+#include "disruptor/adaptive_publisher.h"
 #include "disruptor/ring_buffer.h"
 #include "disruptor/consumer_barrier.h"
 #include "disruptor/wait_strategy.h"
@@ -228,6 +230,31 @@ void runDirectBatchTest(int batchSize, long totalEvents)
     std::cout << "  Direct API (batch=" << batchSize << "):    " << totalEvents / elapsed << " events/s\n";
 }
 
+// Test 5: AdaptiveBatchPublisher - batch size follows the consumer
+void runAdaptiveTest(int maxBatch, long totalEvents)
+{
+    TestContext ctx;
+    ctx.start(totalEvents);
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        disruptor::AdaptiveBatchPolicy policy;
+        policy.maxBatch = maxBatch;
+        disruptor::AdaptiveBatchPublisher<ValueEvent> publisher(ctx.ringBuffer, policy);
+        for (long i = 0; i < totalEvents; ++i)
+        {
+            publisher.claim().value = i;
+            publisher.commit();
+        }
+        publisher.flush();
+    }
+    auto end = std::chrono::steady_clock::now();
+    ctx.finish(totalEvents);
+
+    double elapsed = std::chrono::duration<double>(end - start).count();
+    std::cout << "  Adaptive (max=" << maxBatch << "):     " << totalEvents / elapsed << " events/s\n";
+}
+
 int main()
 {
     constexpr long totalEvents = 100'000'000L;
@@ -266,14 +293,21 @@ int main()
     runDirectBatchTest(500, totalEvents);
     std::cout << "\n";
 
+    // Adaptive
+    std::cout << "--- 5. AdaptiveBatchPublisher ---\n";
+    runAdaptiveTest(100, totalEvents);
+    runAdaptiveTest(1024, totalEvents);
+    std::cout << "\n";
+
     // Summary
     std::cout << "=== Summary ===\n";
     std::cout << "Mode 1 (Fixed): Simple API, good for streaming data\n";
     std::cout << "Mode 2 (Dynamic): Flexible batch size, Java-compatible\n";
-    std::cout << "Direct API: Minimal overhead, maximum control\n\n";
+    std::cout << "Direct API: Minimal overhead, maximum control\n";
+    std::cout << "Adaptive: No batch size to tune, publishes at once when consumers idle\n\n";
 
     // Compare compact vs padded events
-    std::cout << "--- 5. Event Size Comparison (batch=100) ---\n";
+    std::cout << "--- 6. Event Size Comparison (batch=100) ---\n";
     std::cout << "  sizeof(ValueEvent)=" << sizeof(ValueEvent) << " bytes\n";
     std::cout << "  sizeof(PaddedValueEvent)=" << sizeof(PaddedValueEvent) << " bytes\n";
     
@@ -0,0 +1,128 @@
+/**
+ * CombiningPublisherThroughputTest
+ *
+ * Many producers, each publishing single events, into one consumer:
+ *   1. every producer claims with next() and publishes on its own
+ *   2. producers post to a CombiningPublisher, whose combiner claims and
+ *      publishes each batch of requests with one next(n)
+ *
+ * Usage: disruptor_perf_combining_publisher [producers] [eventsPerProducer]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/combining_publisher.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+struct ValueEvent
+{
+    long value{0};
+};
+
+class CountingHandler final : public disruptor::EventHandler<ValueEvent>
+{
+public:
+    void onEvent(ValueEvent& event, long, bool) override
+    {
+        sum += event.value;
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    long sum{0};
+    std::atomic<long> count{0};
+};
+
+template <typename PublishLoop>
+double run(const char* name, int producers, long perProducer, PublishLoop publishLoop)
+{
+    constexpr int bufferSize = 1024 * 64;
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<ValueEvent>::createMultiProducer(
+        [] { return ValueEvent{}; }, bufferSize, waitStrategy);
+
+    CountingHandler handler;
+    auto barrier = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<ValueEvent> processor(ringBuffer, barrier, handler);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+    std::thread consumer([&] { processor.run(); });
+
+    disruptor::CombiningPublisher<ValueEvent> combiner(ringBuffer, producers);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&] {
+            while (!go.load(std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+            publishLoop(ringBuffer, combiner, perProducer);
+        });
+    }
+
+    const long total = producers * perProducer;
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    while (handler.count.load(std::memory_order_acquire) < total)
+    {
+        std::this_thread::yield();
+    }
+    auto end = std::chrono::steady_clock::now();
+    processor.halt();
+    consumer.join();
+
+    double opsPerSec = total / std::chrono::duration<double>(end - start).count();
+    std::cout << "  " << name << ": " << opsPerSec << " events/s";
+    if (combiner.getCombineCount() > 0)
+    {
+        std::cout << " (avg combined batch "
+                  << static_cast<double>(combiner.getPublishedCount()) / combiner.getCombineCount() << ")";
+    }
+    std::cout << "\n";
+    if (handler.sum != total)
+    {
+        std::cerr << "ERROR: sum mismatch\n";
+    }
+    return opsPerSec;
+}
+
+int main(int argc, char** argv)
+{
+    const int producers = argc > 1 ? std::atoi(argv[1]) : 32;
+    const long perProducer = argc > 2 ? std::atol(argv[2]) : 200'000L;
+
+    std::cout << "PerfTest: CombiningPublisherThroughput\n";
+    std::cout << "Producers: " << producers << ", events per producer: " << perProducer << "\n";
+
+    run("next()/publish() per event", producers, perProducer,
+        [](disruptor::RingBuffer<ValueEvent>& ringBuffer, disruptor::CombiningPublisher<ValueEvent>&, long count) {
+            for (long i = 0; i < count; ++i)
+            {
+                long seq = ringBuffer.next();
+                ringBuffer.get(seq).value = 1;
+                ringBuffer.publish(seq);
+            }
+        });
+
+    run("CombiningPublisher        ", producers, perProducer,
+        [](disruptor::RingBuffer<ValueEvent>&, disruptor::CombiningPublisher<ValueEvent>& combiner, long count) {
+            auto producer = combiner.producer();
+            for (long i = 0; i < count; ++i)
+            {
+                producer.publish([](ValueEvent& event) { event.value = 1; });
+            }
+        });
+
+    return 0;
+}
@@ -0,0 +1,442 @@
+// IpcPingPongLatencyTest - 测试跨进程乒乓往返延迟
+// 两个进程通过共享内存中的两个环形缓冲区互相发送事件，并与 Unix 域套接字、管道对比，
+// 用于量化进程边界（如行情接收 → 撮合引擎）相对进程内的开销
+//
+// 用法: disruptor_perf_ipc_ping_pong [iterations] [bufferSize] [busy|yield] [all|shm|uds|pipe] [hiccupUs]
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "disruptor/sequence.h"
+#include "disruptor/wait_strategy.h"
+
+#include "hiccup_meter.h"
+#include "latency_stats.h"
+
+struct PingPongEvent
+{
+    long value = 0;
+};
+
+long parseLong(const char* text, long fallback)
+{
+    if (!text)
+    {
+        return fallback;
+    }
+    char* end = nullptr;
+    long value = std::strtol(text, &end, 10);
+    if (end == text)
+    {
+        return fallback;
+    }
+    return value;
+}
+
+long long nowNanos()
+{
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+// ============================================================================
+// Shared-memory ring
+// ============================================================================
+
+/**
+ * Single-producer/single-consumer ring placed in a shared mapping.
+ * RingBuffer owns heap storage, so it cannot be mapped into two processes;
+ * this keeps the same publication protocol (write slot, release cursor;
+ * consumer releases its own sequence for gating) using the library's padded
+ * Sequence, whose lock-free atomics are address-free and valid across processes.
+ */
+class ShmRing
+{
+public:
+    static size_t bytesFor(int capacity)
+    {
+        return sizeof(ShmRing) + sizeof(PingPongEvent) * static_cast<size_t>(capacity);
+    }
+
+    static ShmRing* create(void* memory, int capacity)
+    {
+        return new (memory) ShmRing(capacity);
+    }
+
+    void publish(long value, bool yield)
+    {
+        long seq = nextValue_ + 1;
+        while (seq - capacity_ > consumed_.get())
+        {
+            idle(yield);
+        }
+        slots()[seq & mask_].value = value;
+        cursor_.set(seq);
+        nextValue_ = seq;
+    }
+
+    long take(bool yield)
+    {
+        long seq = consumed_.getRelaxed() + 1;
+        while (cursor_.get() < seq)
+        {
+            idle(yield);
+        }
+        long value = slots()[seq & mask_].value;
+        consumed_.set(seq);
+        return value;
+    }
+
+private:
+    explicit ShmRing(int capacity) : capacity_(capacity), mask_(capacity - 1) {}
+
+    static void idle(bool yield)
+    {
+        if (yield)
+        {
+            std::this_thread::yield();
+        }
+        else
+        {
+            DISRUPTOR_CPU_PAUSE();
+        }
+    }
+
+    PingPongEvent* slots()
+    {
+        return reinterpret_cast<PingPongEvent*>(this + 1);
+    }
+
+    disruptor::Sequence cursor_;
+    disruptor::Sequence consumed_;
+    // Producer-local; only the publishing process touches it.
+    alignas(128) long nextValue_ = disruptor::Sequence::INITIAL_VALUE;
+    long capacity_;
+    long mask_;
+};
+
+// ============================================================================
+// Transports
+// ============================================================================
+
+/**
+ * Transport interface used by both processes after fork():
+ *   ping side: send(ts); recv() -> ts
+ *   pong side: recv() -> ts; send(ts)
+ */
+struct Transport
+{
+    virtual ~Transport() = default;
+    virtual const char* name() const = 0;
+    virtual void pingSend(long value) = 0;
+    virtual long pingRecv() = 0;
+    virtual void pongSend(long value) = 0;
+    virtual long pongRecv() = 0;
+    virtual void closePingSide() {}
+    virtual void closePongSide() {}
+};
+
+class ShmTransport final : public Transport
+{
+public:
+    ShmTransport(int capacity, bool yield) : yield_(yield)
+    {
+        if (capacity < 1 || (capacity & (capacity - 1)) != 0)
+        {
+            throw std::invalid_argument("bufferSize must be a power of 2");
+        }
+        std::string name = "/disruptor_ipc_ping_pong_" + std::to_string(getpid());
+        int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        if (fd < 0)
+        {
+            throw std::runtime_error("shm_open failed: " + std::string(std::strerror(errno)));
+        }
+        size_t ringBytes = (ShmRing::bytesFor(capacity) + 127) & ~size_t(127);
+        bytes_ = ringBytes * 2;
+        if (ftruncate(fd, static_cast<off_t>(bytes_)) != 0)
+        {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error("ftruncate failed: " + std::string(std::strerror(errno)));
+        }
+        memory_ = mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        // The mapping survives unlink and fork(); nothing is left behind in /dev/shm.
+        shm_unlink(name.c_str());
+        if (memory_ == MAP_FAILED)
+        {
+            throw std::runtime_error("mmap failed: " + std::string(std::strerror(errno)));
+        }
+        ping_ = ShmRing::create(memory_, capacity);
+        pong_ = ShmRing::create(static_cast<char*>(memory_) + ringBytes, capacity);
+    }
+
+    ~ShmTransport() override
+    {
+        munmap(memory_, bytes_);
+    }
+
+    const char* name() const override { return "SharedMemoryRing"; }
+    void pingSend(long value) override { ping_->publish(value, yield_); }
+    long pingRecv() override { return pong_->take(yield_); }
+    void pongSend(long value) override { pong_->publish(value, yield_); }
+    long pongRecv() override { return ping_->take(yield_); }
+
+private:
+    bool yield_;
+    void* memory_ = nullptr;
+    size_t bytes_ = 0;
+    ShmRing* ping_ = nullptr;
+    ShmRing* pong_ = nullptr;
+};
+
+void writeFully(int fd, long value)
+{
+    const char* p = reinterpret_cast<const char*>(&value);
+    size_t left = sizeof(value);
+    while (left > 0)
+    {
+        ssize_t n = write(fd, p, left);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            throw std::runtime_error("write failed: " + std::string(std::strerror(errno)));
+        }
+        p += n;
+        left -= static_cast<size_t>(n);
+    }
+}
+
+long readFully(int fd)
+{
+    long value = 0;
+    char* p = reinterpret_cast<char*>(&value);
+    size_t left = sizeof(value);
+    while (left > 0)
+    {
+        ssize_t n = read(fd, p, left);
+        if (n < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (n <= 0)
+        {
+            throw std::runtime_error("read failed");
+        }
+        p += n;
+        left -= static_cast<size_t>(n);
+    }
+    return value;
+}
+
+/**
+ * Two descriptors per side. For a socketpair both pairs refer to the same
+ * bidirectional socket; for pipes they are two unidirectional pipes.
+ */
+class FdTransport final : public Transport
+{
+public:
+    enum class Kind
+    {
+        UnixSocket,
+        Pipe
+    };
+
+    explicit FdTransport(Kind kind) : kind_(kind)
+    {
+        if (kind == Kind::UnixSocket)
+        {
+            int sv[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+            {
+                throw std::runtime_error("socketpair failed: " + std::string(std::strerror(errno)));
+            }
+            pingRead_ = pingWrite_ = sv[0];
+            pongRead_ = pongWrite_ = sv[1];
+        }
+        else
+        {
+            int toPong[2];
+            int toPing[2];
+            if (pipe(toPong) != 0 || pipe(toPing) != 0)
+            {
+                throw std::runtime_error("pipe failed: " + std::string(std::strerror(errno)));
+            }
+            pongRead_ = toPong[0];
+            pingWrite_ = toPong[1];
+            pingRead_ = toPing[0];
+            pongWrite_ = toPing[1];
+        }
+    }
+
+    ~FdTransport() override
+    {
+        closePingSide();
+        closePongSide();
+    }
+
+    const char* name() const override
+    {
+        return kind_ == Kind::UnixSocket ? "UnixDomainSocket" : "Pipe";
+    }
+
+    void pingSend(long value) override { writeFully(pingWrite_, value); }
+    long pingRecv() override { return readFully(pingRead_); }
+    void pongSend(long value) override { writeFully(pongWrite_, value); }
+    long pongRecv() override { return readFully(pongRead_); }
+
+    void closePingSide() override { closePair(pingRead_, pingWrite_); }
+    void closePongSide() override { closePair(pongRead_, pongWrite_); }
+
+private:
+    static void closePair(int& readFd, int& writeFd)
+    {
+        if (readFd >= 0)
+        {
+            close(readFd);
+        }
+        if (writeFd >= 0 && writeFd != readFd)
+        {
+            close(writeFd);
+        }
+        readFd = writeFd = -1;
+    }
+
+    Kind kind_;
+    int pingRead_ = -1;
+    int pingWrite_ = -1;
+    int pongRead_ = -1;
+    int pongWrite_ = -1;
+};
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+/**
+ * Forks a ponger process, runs the round trips from the parent and reports.
+ * A negative value is the ponger's stop signal.
+ */
+void runTransport(Transport& transport, long iterations, long hiccupResolutionUs)
+{
+    pid_t child = fork();
+    if (child < 0)
+    {
+        throw std::runtime_error("fork failed: " + std::string(std::strerror(errno)));
+    }
+    if (child == 0)
+    {
+        transport.closePingSide();
+        int status = 0;
+        try
+        {
+            while (true)
+            {
+                long value = transport.pongRecv();
+                if (value < 0)
+                {
+                    break;
+                }
+                transport.pongSend(value);
+            }
+        }
+        catch (...)
+        {
+            status = 1;
+        }
+        _exit(status);
+    }
+
+    transport.closePongSide();
+
+    // Warm up both processes and the transport before timing.
+    for (long i = 0; i < std::min<long>(iterations / 10, 10'000); ++i)
+    {
+        transport.pingSend(nowNanos());
+        (void)transport.pingRecv();
+    }
+
+    std::vector<long long> latencies;
+    latencies.reserve(static_cast<size_t>(iterations));
+
+    // Started after fork(), so only the pinging process carries the meter thread.
+    HiccupMeter hiccupMeter(std::chrono::microseconds(hiccupResolutionUs > 0 ? hiccupResolutionUs : 1));
+    if (hiccupResolutionUs > 0)
+    {
+        hiccupMeter.start();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i)
+    {
+        transport.pingSend(nowNanos());
+        long sent = transport.pingRecv();
+        latencies.push_back(nowNanos() - sent);
+    }
+    auto end = std::chrono::steady_clock::now();
+    hiccupMeter.stop();
+
+    transport.pingSend(-1);
+    int status = 0;
+    waitpid(child, &status, 0);
+
+    double totalSeconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "\nTransport: " << transport.name() << "\n";
+    std::cout << "Total Time(s): " << totalSeconds << "\n";
+    std::cout << "Throughput(round-trips/s): " << iterations / totalSeconds << "\n";
+    printLatencyStatistics(std::cout, "Latency Statistics", latencies);
+    if (hiccupResolutionUs > 0)
+    {
+        printHiccupStatistics(std::cout, hiccupMeter);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    long iterations = parseLong(argc > 1 ? argv[1] : nullptr, 1'000'000L);
+    int bufferSize = static_cast<int>(parseLong(argc > 2 ? argv[2] : nullptr, 1024));
+    std::string wait = (argc > 3 && argv[3]) ? std::string(argv[3]) : std::string("busy");
+    std::string which = (argc > 4 && argv[4]) ? std::string(argv[4]) : std::string("all");
+    // 平台抖动测量分辨率（微秒），0 表示关闭
+    long hiccupResolutionUs = parseLong(argc > 5 ? argv[5] : nullptr, 1000);
+    bool yield = wait == "yield" || wait == "yielding";
+
+    std::cout << "PerfTest: IpcPingPongLatency\n";
+    std::cout << "WaitStrategy(shm): " << (yield ? "Yielding" : "BusySpin") << "\n";
+    std::cout << "BufferSize: " << bufferSize << "\n";
+    std::cout << "Iterations: " << iterations << "\n";
+
+    if (which == "all" || which == "shm")
+    {
+        ShmTransport shm(bufferSize, yield);
+        runTransport(shm, iterations, hiccupResolutionUs);
+    }
+    if (which == "all" || which == "uds")
+    {
+        FdTransport uds(FdTransport::Kind::UnixSocket);
+        runTransport(uds, iterations, hiccupResolutionUs);
+    }
+    if (which == "all" || which == "pipe")
+    {
+        FdTransport pipes(FdTransport::Kind::Pipe);
+        runTransport(pipes, iterations, hiccupResolutionUs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,314 @@
+// NoisyNeighbourTest - 测试干扰负载下各等待策略的吞吐与尾延迟退化
+// 拓扑：1 个生产者 -> 1 个消费者，同时运行可配置的干扰线程
+// （内存带宽占用 / 缓存抖动 / 同核超订），与安静环境对比
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/event_handler.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+#include "hiccup_meter.h"
+#include "interference.h"
+#include "latency_stats.h"
+
+struct TimedEvent
+{
+    long value = 0;
+    long long publishNanos = 0;
+};
+
+inline long long nowNanos()
+{
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+class TimedHandler final : public disruptor::EventHandler<TimedEvent>
+{
+public:
+    void reset(long expectedCount, bool recordLatency)
+    {
+        expectedCount_ = expectedCount;
+        recordLatency_ = recordLatency;
+        count_ = 0;
+        sum_ = 0;
+        latencies_.clear();
+        if (recordLatency)
+        {
+            latencies_.reserve(static_cast<size_t>(expectedCount));
+        }
+        done_.store(false, std::memory_order_relaxed);
+    }
+
+    void onEvent(TimedEvent& evt, long, bool endOfBatch) override
+    {
+        if (recordLatency_)
+        {
+            latencies_.push_back(nowNanos() - evt.publishNanos);
+        }
+        sum_ += evt.value;
+        ++count_;
+        if (endOfBatch && count_ >= expectedCount_)
+        {
+            done_.store(true, std::memory_order_release);
+        }
+    }
+
+    bool isDone() const { return done_.load(std::memory_order_acquire); }
+    std::vector<long long>& getLatencies() { return latencies_; }
+
+private:
+    long expectedCount_ = 0;
+    bool recordLatency_ = false;
+    long count_ = 0;
+    long long sum_ = 0;
+    std::vector<long long> latencies_;
+    std::atomic<bool> done_{false};
+};
+
+long parseLong(const char* text, long fallback)
+{
+    if (!text)
+    {
+        return fallback;
+    }
+    char* end = nullptr;
+    long value = std::strtol(text, &end, 10);
+    if (end == text)
+    {
+        return fallback;
+    }
+    return value;
+}
+
+static void pinCurrentThread(int cpu)
+{
+#ifdef __linux__
+    if (cpu < 0)
+    {
+        return;
+    }
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu, &cpuset);
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (rc != 0)
+    {
+        std::cerr << "pthread_setaffinity_np(cpu=" << cpu << ") failed: " << rc << "\n";
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+static std::unique_ptr<disruptor::WaitStrategy> makeWaitStrategy(const std::string& name)
+{
+    if (name == "yield")
+    {
+        return std::make_unique<disruptor::YieldingWaitStrategy>();
+    }
+    if (name == "sleep")
+    {
+        return std::make_unique<disruptor::SleepingWaitStrategy>();
+    }
+    if (name == "blocking")
+    {
+        return std::make_unique<disruptor::BlockingWaitStrategy>();
+    }
+    return std::make_unique<disruptor::BusySpinWaitStrategy>();
+}
+
+struct PhaseResult
+{
+    double opsPerSecond = 0.0;
+    LatencyStatistics latency;
+    LatencyStatistics hiccups;
+};
+
+/**
+ * Run the 1P:1C pipeline once. The producer is the calling thread, pinned by main().
+ * intervalNanos == 0: saturating throughput phase.
+ * intervalNanos > 0:  paced latency phase (one event per interval), with the
+ *                     hiccup meter running beside it; its samples are appended
+ *                     to hiccups.
+ */
+static PhaseResult runPipeline(const std::string& wait, long iterations, long intervalNanos, int bufferSize,
+                               int consumerCpu, HiccupMeter* hiccupMeter = nullptr,
+                               std::vector<long long>* hiccups = nullptr)
+{
+    auto waitStrategy = makeWaitStrategy(wait);
+    auto ringBuffer = disruptor::RingBuffer<TimedEvent>::createSingleProducer(
+        [] { return TimedEvent{}; }, bufferSize, *waitStrategy);
+
+    auto barrier = ringBuffer.newBarrier();
+    TimedHandler handler;
+    handler.reset(iterations, intervalNanos > 0);
+
+    disruptor::BatchEventProcessor<TimedEvent> processor(ringBuffer, barrier, handler);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    std::thread consumerThread([&] {
+        pinCurrentThread(consumerCpu);
+        processor.run();
+    });
+
+    if (hiccupMeter)
+    {
+        hiccupMeter->start();
+    }
+    auto start = std::chrono::steady_clock::now();
+    long long nextPublish = nowNanos();
+    for (long i = 0; i < iterations; ++i)
+    {
+        if (intervalNanos > 0)
+        {
+            nextPublish += intervalNanos;
+            while (nowNanos() < nextPublish)
+            {
+                DISRUPTOR_CPU_PAUSE();
+            }
+        }
+        long seq = ringBuffer.next();
+        auto& evt = ringBuffer.get(seq);
+        evt.value = i;
+        evt.publishNanos = nowNanos();
+        ringBuffer.publish(seq);
+    }
+
+    while (!handler.isDone())
+    {
+        std::this_thread::yield();
+    }
+    auto end = std::chrono::steady_clock::now();
+    if (hiccupMeter)
+    {
+        hiccupMeter->stop();
+    }
+
+    processor.halt();
+    consumerThread.join();
+
+    PhaseResult result;
+    double seconds = std::chrono::duration<double>(end - start).count();
+    result.opsPerSecond = iterations / seconds;
+    if (intervalNanos > 0)
+    {
+        result.latency = computeLatencyStatistics(handler.getLatencies());
+    }
+    if (hiccupMeter)
+    {
+        auto& samples = hiccupMeter->getHiccups();
+        hiccups->insert(hiccups->end(), samples.begin(), samples.end());
+        result.hiccups = computeLatencyStatistics(samples);
+    }
+    return result;
+}
+
+int main(int argc, char** argv)
+{
+    long iterations = parseLong(argc > 1 ? argv[1] : nullptr, 10'000'000L);
+    int bufferSize = static_cast<int>(parseLong(argc > 2 ? argv[2] : nullptr, 1 << 16));
+    std::string kindName = (argc > 3 && argv[3]) ? std::string(argv[3]) : std::string("membw");
+    int interferers = static_cast<int>(parseLong(argc > 4 ? argv[4] : nullptr, 2));
+    // same: 干扰线程绑定到流水线所在核心（超订）；other: 不绑定，由调度器放置
+    std::string placement = (argc > 5 && argv[5]) ? std::string(argv[5]) : std::string("other");
+    int producerCpu = static_cast<int>(parseLong(argc > 6 ? argv[6] : nullptr, 0));
+    int consumerCpu = static_cast<int>(parseLong(argc > 7 ? argv[7] : nullptr, 1));
+    long workingSetMb = parseLong(argc > 8 ? argv[8] : nullptr, 64);
+    long latencySamples = parseLong(argc > 9 ? argv[9] : nullptr, 100'000L);
+    long latencyIntervalNanos = parseLong(argc > 10 ? argv[10] : nullptr, 5'000L);
+    // 延迟阶段旁运行的抖动测量分辨率（微秒）
+    long hiccupResolutionUs = std::max(1L, parseLong(argc > 11 ? argv[11] : nullptr, 1000));
+
+    auto kind = InterferenceLoad::parseKind(kindName);
+    std::vector<int> interferenceCpus;
+    if (placement == "same")
+    {
+        interferenceCpus = {producerCpu, consumerCpu};
+    }
+
+    pinCurrentThread(producerCpu);
+
+    std::cout << "PerfTest: NoisyNeighbour (1P:1C)\n";
+    std::cout << "Interference: " << InterferenceLoad::kindName(kind) << " x" << interferers
+              << " (" << (placement == "same" ? "pinned to pipeline cores" : "unpinned") << ")\n";
+    std::cout << "WorkingSet(MB/thread): " << workingSetMb << "\n";
+    std::cout << "BufferSize: " << bufferSize << "\n";
+    std::cout << "Iterations: " << iterations << "\n";
+    std::cout << "Latency samples: " << latencySamples << " @ " << latencyIntervalNanos << "ns interval\n";
+    std::cout << "Pinning: producer->CPU" << producerCpu << ", consumer->CPU" << consumerCpu << "\n\n";
+
+    std::cout << std::left << std::setw(10) << "Strategy"
+              << std::right << std::setw(14) << "Quiet(ops/s)"
+              << std::setw(14) << "Noisy(ops/s)"
+              << std::setw(10) << "Tput%"
+              << std::setw(14) << "QuietP99(ns)"
+              << std::setw(14) << "NoisyP99(ns)"
+              << std::setw(16) << "NoisyP99.9(ns)"
+              << std::setw(10) << "P99x"
+              << std::setw(17) << "QuietHicP99(ns)"
+              << std::setw(17) << "NoisyHicP99(ns)" << "\n";
+
+    // 区分平台停顿（中断、调度抢占）与干扰负载本身造成的延迟
+    HiccupMeter hiccupMeter{std::chrono::microseconds(hiccupResolutionUs)};
+    std::vector<long long> quietHiccups;
+    std::vector<long long> noisyHiccups;
+
+    const std::vector<std::string> strategies = {"busy", "yield", "sleep", "blocking"};
+    for (const auto& wait : strategies)
+    {
+        auto quietTput = runPipeline(wait, iterations, 0, bufferSize, consumerCpu);
+        auto quietLat = runPipeline(wait, latencySamples, latencyIntervalNanos, bufferSize, consumerCpu,
+                                    &hiccupMeter, &quietHiccups);
+
+        PhaseResult noisyTput;
+        PhaseResult noisyLat;
+        {
+            InterferenceLoad load(kind, interferers, static_cast<size_t>(workingSetMb) << 20, interferenceCpus);
+            load.start();
+            noisyTput = runPipeline(wait, iterations, 0, bufferSize, consumerCpu);
+            noisyLat = runPipeline(wait, latencySamples, latencyIntervalNanos, bufferSize, consumerCpu,
+                                   &hiccupMeter, &noisyHiccups);
+            load.stop();
+        }
+
+        double tputChange = (noisyTput.opsPerSecond / quietTput.opsPerSecond - 1.0) * 100.0;
+        double p99Ratio = quietLat.latency.p99 > 0
+            ? static_cast<double>(noisyLat.latency.p99) / quietLat.latency.p99
+            : 0.0;
+
+        std::cout << std::left << std::setw(10) << wait << std::right
+                  << std::setprecision(3) << std::scientific
+                  << std::setw(14) << quietTput.opsPerSecond
+                  << std::setw(14) << noisyTput.opsPerSecond
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(10) << tputChange
+                  << std::setw(14) << quietLat.latency.p99
+                  << std::setw(14) << noisyLat.latency.p99
+                  << std::setw(16) << noisyLat.latency.p999
+                  << std::setprecision(2)
+                  << std::setw(10) << p99Ratio
+                  << std::setw(17) << quietLat.hiccups.p99
+                  << std::setw(17) << noisyLat.hiccups.p99 << "\n";
+    }
+
+    std::cout << "\nHiccupMeter: " << HiccupMeter::modeName(hiccupMeter.getMode()) << ", resolution "
+              << hiccupResolutionUs << "us, latency phases\n";
+    printLatencyStatistics(std::cout, "Hiccup Statistics (quiet)", quietHiccups);
+    printLatencyStatistics(std::cout, "Hiccup Statistics (noisy)", noisyHiccups);
+
+    return 0;
+}
@@ -15,6 +15,9 @@
 #include "disruptor/ring_buffer.h"
 #include "disruptor/wait_strategy.h"
 
+#include "hiccup_meter.h"
+#include "latency_stats.h"
+
 struct PingPongEvent
 {
     long value = 0;
@@ -115,6 +118,8 @@ int main(int argc, char** argv)
     long iterations = parseLong(argc > 1 ? argv[1] : nullptr, 1'000'000L);
     int bufferSize = static_cast<int>(parseLong(argc > 2 ? argv[2] : nullptr, 1024));
     std::string wait = (argc > 3 && argv[3]) ? std::string(argv[3]) : std::string("busy");
+    // 平台抖动测量分辨率（微秒），0 表示关闭
+    long hiccupResolutionUs = parseLong(argc > 4 ? argv[4] : nullptr, 1000);
 
     disruptor::BusySpinWaitStrategy busyPing;
     disruptor::BusySpinWaitStrategy busyPong;
@@ -153,6 +158,13 @@ int main(int argc, char** argv)
     // 等待处理器启动
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
 
+    // 与测试并行运行抖动测量线程，区分平台停顿与 RingBuffer 延迟
+    HiccupMeter hiccupMeter(std::chrono::microseconds(hiccupResolutionUs > 0 ? hiccupResolutionUs : 1));
+    if (hiccupResolutionUs > 0)
+    {
+        hiccupMeter.start();
+    }
+
     auto start = std::chrono::steady_clock::now();
 
     // 发送第一个 ping
@@ -165,6 +177,7 @@ int main(int argc, char** argv)
     }
 
     auto end = std::chrono::steady_clock::now();
+    hiccupMeter.stop();
 
     // 停止处理器
     pingerProcessor.halt();
@@ -174,39 +187,22 @@ int main(int argc, char** argv)
 
     // 计算统计数据
     auto latencies = pinger.getLatencies();
-    std::sort(latencies.begin(), latencies.end());
 
     auto totalNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
     double totalSeconds = totalNanos / 1'000'000'000.0;
 
-    long long minLatency = latencies.front();
-    long long maxLatency = latencies.back();
-    long long p50 = latencies[latencies.size() / 2];
-    long long p90 = latencies[static_cast<size_t>(latencies.size() * 0.9)];
-    long long p99 = latencies[static_cast<size_t>(latencies.size() * 0.99)];
-    long long p999 = latencies[static_cast<size_t>(latencies.size() * 0.999)];
-
-    long long sum = 0;
-    for (auto lat : latencies)
-    {
-        sum += lat;
-    }
-    double avgLatency = static_cast<double>(sum) / latencies.size();
-
     std::cout << "PerfTest: PingPongSequencedLatency\n";
     std::cout << "WaitStrategy: " << ((wait == "yield" || wait == "yielding") ? "Yielding" : "BusySpin") << "\n";
     std::cout << "BufferSize: " << bufferSize << "\n";
     std::cout << "Iterations: " << iterations << "\n";
     std::cout << "Total Time(s): " << totalSeconds << "\n";
     std::cout << "Throughput(round-trips/s): " << iterations / totalSeconds << "\n";
-    std::cout << "\nLatency Statistics (ns):\n";
-    std::cout << "  Min:    " << minLatency << "\n";
-    std::cout << "  Avg:    " << std::fixed << std::setprecision(2) << avgLatency << "\n";
-    std::cout << "  P50:    " << p50 << "\n";
-    std::cout << "  P90:    " << p90 << "\n";
-    std::cout << "  P99:    " << p99 << "\n";
-    std::cout << "  P99.9:  " << p999 << "\n";
-    std::cout << "  Max:    " << maxLatency << "\n";
+    printLatencyStatistics(std::cout, "Latency Statistics", latencies);
+
+    if (hiccupResolutionUs > 0)
+    {
+        printHiccupStatistics(std::cout, hiccupMeter);
+    }
 
     return 0;
 }
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include "ring_buffer.h"
+#include "util.h"
+
+namespace disruptor
+{
+
+/**
+ * Bounds for AdaptiveBatchPublisher.
+ */
+struct AdaptiveBatchPolicy
+{
+    /** Smallest batch target; the target returns here while consumers keep up. */
+    int minBatch = 1;
+
+    /** Largest batch target; the target doubles towards it while consumers lag. */
+    int maxBatch = 1024;
+
+    /** No committed event waits longer than this (checked on commit() and flushIfDue()). */
+    std::chrono::nanoseconds maxDelay = std::chrono::microseconds(100);
+};
+
+/**
+ * Self-tuning batch publisher, in the spirit of Nagle's algorithm but
+ * latency-safe: a commit that finds the consumers idle publishes everything
+ * held at once; while they are still working through earlier events, commits
+ * are held and published together, since the consumers could not have started
+ * on them yet anyway. Only held commits read the consumers' position, and
+ * those happen while the consumers, not the producer, are the bottleneck.
+ * The batch target doubles each time a full batch finds the consumers still
+ * behind and halves whenever they have caught up, and nothing is held past
+ * policy.maxDelay.
+ *
+ *   AdaptiveBatchPublisher<Event> publisher(ringBuffer);
+ *   while (auto msg = source.poll()) {
+ *       publisher.claim() = *msg;
+ *       publisher.commit();
+ *   }
+ *   publisher.flushIfDue();  // from the idle path, or flush() when done
+ *
+ * Held events are only re-examined on commit() and flushIfDue(); a producer
+ * that may go quiet for long must call one of them (or flush()) from its idle
+ * path. Owned by one thread. Slots are claimed a batch target at a time, so on
+ * a multi-producer ring an early flush leaves claimed, unwritten slots that
+ * hide other producers' later events until this publisher fills them; intended
+ * for single-producer rings, like BatchPublisher. Flushes on destruction;
+ * slots claimed ahead but never committed are left unpublished, so keep one
+ * publisher per ring for its lifetime.
+ */
+template <typename T>
+class AdaptiveBatchPublisher
+{
+public:
+    explicit AdaptiveBatchPublisher(RingBuffer<T>& ringBuffer, AdaptiveBatchPolicy policy = {})
+        : ringBuffer_(ringBuffer), policy_(policy), lastPublished_(ringBuffer.getCursor())
+    {
+        policy_.maxBatch = std::max(1, std::min(policy_.maxBatch, ringBuffer.getBufferSize()));
+        policy_.minBatch = std::max(1, std::min(policy_.minBatch, policy_.maxBatch));
+        target_ = policy_.minBatch;
+    }
+
+    ~AdaptiveBatchPublisher()
+    {
+        flush();
+    }
+
+    AdaptiveBatchPublisher(const AdaptiveBatchPublisher&) = delete;
+    AdaptiveBatchPublisher& operator=(const AdaptiveBatchPublisher&) = delete;
+
+    /**
+     * Slot for the next event. Fill it, then commit().
+     */
+    T& claim()
+    {
+        if (nextSequence_ > claimedHi_)
+        {
+            const int n = std::max(1, target_ - pending_);
+            claimedHi_ = ringBuffer_.next(n);
+            nextSequence_ = claimedHi_ - n + 1;
+            if (pending_ > 0 && nextSequence_ != pendingLo_ + pending_)
+            {
+                // Another producer claimed in between: ranges must stay contiguous.
+                publishPending();
+            }
+        }
+        return ringBuffer_.get(nextSequence_);
+    }
+
+    /**
+     * Mark the claimed slot written; publishes now or holds it per the policy.
+     */
+    void commit()
+    {
+        if (pending_++ == 0)
+        {
+            pendingLo_ = nextSequence_;
+        }
+        ++nextSequence_;
+
+        if (pending_ >= target_)
+        {
+            const bool consumersBehind = !consumersCaughtUp();
+            publishPending();
+            target_ = consumersBehind ? std::min(target_ * 2, policy_.maxBatch) : std::max(target_ / 2, policy_.minBatch);
+        }
+        else if (consumersCaughtUp())
+        {
+            publishPending();
+            target_ = std::max(target_ / 2, policy_.minBatch);
+        }
+        else if (pending_ == 1)
+        {
+            heldSince_ = steadyClockNanos();
+        }
+        else if (steadyClockNanos() - heldSince_ >= policy_.maxDelay.count())
+        {
+            publishPending();
+        }
+    }
+
+    /**
+     * Publish held events if the consumers have caught up or the oldest has
+     * waited maxDelay. Call from the producer's idle path. Returns true if
+     * anything was published.
+     */
+    bool flushIfDue()
+    {
+        if (pending_ == 0)
+        {
+            return false;
+        }
+        if (consumersCaughtUp() || steadyClockNanos() - heldSince_ >= policy_.maxDelay.count())
+        {
+            publishPending();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Publish every committed event now.
+     */
+    void flush()
+    {
+        if (pending_ > 0)
+        {
+            publishPending();
+        }
+    }
+
+    int getTargetBatchSize() const { return target_; }
+    int getPendingCount() const { return pending_; }
+    long getPublishedBatchCount() const { return batches_; }
+
+private:
+    bool consumersCaughtUp()
+    {
+        // The cached position only ever lags the real one, so a hit is exact.
+        if (consumerSequence_ < lastPublished_)
+        {
+            consumerSequence_ = ringBuffer_.getMinimumGatingSequence();
+        }
+        return consumerSequence_ >= lastPublished_;
+    }
+
+    void publishPending()
+    {
+        lastPublished_ = pendingLo_ + pending_ - 1;
+        ringBuffer_.publish(pendingLo_, lastPublished_);
+        pending_ = 0;
+        ++batches_;
+    }
+
+    RingBuffer<T>& ringBuffer_;
+    AdaptiveBatchPolicy policy_;
+    long lastPublished_;
+    int target_;
+    int pending_ = 0;
+    long pendingLo_ = 0;
+    long nextSequence_ = 0;
+    long claimedHi_ = -1;
+    long consumerSequence_ = Sequence::INITIAL_VALUE;
+    int64_t heldSince_ = 0;
+    long batches_ = 0;
+};
+
+} // namespace disruptor
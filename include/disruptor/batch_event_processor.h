@@ -1,7 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <exception>
+#include <functional>
+#include <utility>
 #include <thread>
 
 #include "event_handler.h"
@@ -10,6 +14,7 @@
 #include "ring_buffer.h"
 #include "sequence.h"
 #include "consumer_barrier.h"
+#include "util.h"
 
 namespace disruptor
 {
@@ -27,6 +32,50 @@ public:
         exceptionHandler = &handler;
     }
 
+    /**
+     * Skip events older than ttl without calling the handler. publishTime
+     * returns the event's publish stamp in steadyClockNanos() units. Stamps are
+     * assumed non-decreasing in sequence order, so a stale run is found with
+     * one clock read and a binary search per batch and skipped by advancing
+     * the sequence; skipped events are counted in getExpiredCount(). With
+     * several producers, events stamped out of order right at the cutoff may
+     * go either way. Call before run().
+     */
+    void setTimeToLive(std::chrono::nanoseconds ttl, std::function<int64_t(const T&)> publishTime)
+    {
+        ttlNanos = ttl.count();
+        publishTimeOf = std::move(publishTime);
+    }
+
+    /** Events skipped as expired. */
+    long getExpiredCount() const { return expired.load(std::memory_order_relaxed); }
+
+    /**
+     * Enable catch-up mode: the handler gets onBatchStart with its lag before
+     * every batch, and batches of at least threshold events are offered to
+     * onCatchUp as one range. LONG_MAX gives lag notifications only; 0 (the
+     * default) turns both off. Call before run().
+     */
+    void setCatchUpThreshold(long threshold)
+    {
+        catchUpThreshold = threshold;
+    }
+
+    /** Batches consumed whole by onCatchUp. */
+    long getCatchUpCount() const { return catchUps.load(std::memory_order_relaxed); }
+
+    /**
+     * Coalesce wakeups: wait until minEvents events are available, or maxDelay
+     * has passed since the wait began with at least one available. Meant for
+     * throughput stages; adds up to maxDelay latency. minEvents <= 1 turns it
+     * off. Call before run().
+     */
+    void setWakeupWatermark(long minEvents, std::chrono::nanoseconds maxDelay)
+    {
+        watermarkEvents = minEvents;
+        watermarkDelay = maxDelay;
+    }
+
     void run() override
     {
         running.store(true, std::memory_order_release);
@@ -36,17 +85,48 @@ public:
         try
         {
             long nextSequence = sequence.get() + 1;
+            long current = nextSequence;
             T* event = nullptr;
 
             while (running.load(std::memory_order_acquire))
             {
                 try
                 {
-                    long available = barrier.waitFor(nextSequence);
-                    for (long seq = nextSequence; seq <= available; ++seq)
+                    long available = watermarkEvents > 1
+                                         ? barrier.waitFor(nextSequence, watermarkEvents, watermarkDelay)
+                                         : barrier.waitFor(nextSequence);
+                    if (publishTimeOf && available >= nextSequence)
+                    {
+                        // A throwing publishTimeOf is reported against the first event of the range.
+                        current = nextSequence;
+                        event = &ringBuffer.get(current);
+                        nextSequence = skipExpired(nextSequence, available);
+                    }
+                    if (catchUpThreshold > 0 && available >= nextSequence)
+                    {
+                        // A throwing onCatchUp is reported against the first event of the range.
+                        current = nextSequence;
+                        event = nullptr;
+                        if (catchUp(nextSequence, available))
+                        {
+                            nextSequence = available + 1;
+                        }
+                    }
+                    for (current = nextSequence; current <= available; ++current)
+                    {
+                        // Out of the gating set, any slot not yet delivered may be
+                        // mid-overwrite, so stop at the first one.
+                        if (__builtin_expect(evicted.load(std::memory_order_relaxed), 0))
+                        {
+                            break;
+                        }
+                        event = &ringBuffer.get(current);
+                        handler.onEvent(*event, current, current == available);
+                    }
+                    if (__builtin_expect(evicted.load(std::memory_order_acquire), 0))
                     {
-                        event = &ringBuffer.get(seq);
-                        handler.onEvent(*event, seq, seq == available);
+                        nextSequence = rejoin(current);
+                        continue;
                     }
                     sequence.set(available);
                     nextSequence = available + 1;
@@ -60,9 +140,10 @@ public:
                 }
                 catch (...)
                 {
-                    handleEventException(std::current_exception(), nextSequence, event);
-                    sequence.set(nextSequence);
-                    ++nextSequence;
+                    // Skip only the failing event; earlier events in the batch are done.
+                    handleEventException(std::current_exception(), current, event);
+                    sequence.set(current);
+                    nextSequence = current + 1;
                 }
             }
         }
@@ -93,7 +174,113 @@ public:
         return sequence;
     }
 
+    /**
+     * Drop this processor from the ring's gating set so producers stop waiting
+     * for it (see SlowConsumerMonitor). The processor notices before its next
+     * event, reports the skipped range through EventHandler::onLapped and
+     * rejoins the gating set at the cursor. Only for leaf consumers: anything
+     * gated on this processor's sequence would skip along with it.
+     *
+     * Returns false if the processor was not a gating sequence of the ring.
+     */
+    bool evict()
+    {
+        if (evicted.load(std::memory_order_acquire) || !ringBuffer.removeGatingSequence(&sequence))
+        {
+            return false;
+        }
+        evicted.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /** True between evict() and the processor rejoining. */
+    bool isEvicted() const { return evicted.load(std::memory_order_acquire); }
+
+    /** Events skipped across all evictions. */
+    long getLappedCount() const { return lapped.load(std::memory_order_relaxed); }
+
 private:
+    /**
+     * Lag notification, then the bulk path for a large enough batch. Returns
+     * true if onCatchUp consumed [lo, hi].
+     */
+    bool catchUp(long lo, long hi)
+    {
+        handler.onBatchStart(lo, hi, ringBuffer.getCursor() - lo + 1);
+        if (hi - lo + 1 < catchUpThreshold)
+        {
+            return false;
+        }
+
+        EventRange<T> backlog(ringBuffer.getEntries(), ringBuffer.getIndexMask(), lo, hi);
+        if (!handler.onCatchUp(backlog))
+        {
+            return false;
+        }
+        catchUps.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Returns the first sequence in [lo, hi] that has not expired (hi + 1 if none).
+     */
+    long skipExpired(long lo, long hi)
+    {
+        const int64_t cutoff = steadyClockNanos() - ttlNanos;
+        if (publishTimeOf(ringBuffer.get(lo)) >= cutoff)
+        {
+            return lo;
+        }
+
+        long left = lo + 1;
+        long right = hi + 1;
+        while (left < right)
+        {
+            long mid = left + (right - left) / 2;
+            if (publishTimeOf(ringBuffer.get(mid)) < cutoff)
+            {
+                left = mid + 1;
+            }
+            else
+            {
+                right = mid;
+            }
+        }
+        expired.fetch_add(left - lo, std::memory_order_relaxed);
+        sequence.set(left - 1);
+        return left;
+    }
+
+    long rejoin(long firstSkipped)
+    {
+        long rejoinAt = ringBuffer.getCursor();
+        sequence.set(rejoinAt);
+        ringBuffer.addGatingSequences({&sequence});
+        // Claims made before we were back in the gating set may already be
+        // reusing slots up to claimBound - bufferSize.
+        long overwritten = ringBuffer.getClaimBound() - ringBuffer.getBufferSize();
+        if (rejoinAt < overwritten)
+        {
+            rejoinAt = overwritten;
+            sequence.set(rejoinAt);
+        }
+        evicted.store(false, std::memory_order_release);
+
+        if (rejoinAt >= firstSkipped)
+        {
+            lapped.fetch_add(rejoinAt - firstSkipped + 1, std::memory_order_relaxed);
+            try
+            {
+                handler.onLapped(firstSkipped, rejoinAt);
+            }
+            catch (...)
+            {
+                handleEventException(std::current_exception(), rejoinAt, nullptr);
+            }
+        }
+        return rejoinAt + 1;
+    }
+
     void notifyStart()
     {
         try
@@ -134,5 +321,14 @@ private:
     ExceptionHandler<T>* exceptionHandler{nullptr};
     Sequence sequence{Sequence::INITIAL_VALUE};
     std::atomic<bool> running{false};
+    std::atomic<bool> evicted{false};
+    std::atomic<long> lapped{0};
+    int64_t ttlNanos = 0;
+    std::function<int64_t(const T&)> publishTimeOf;
+    std::atomic<long> expired{0};
+    long catchUpThreshold = 0;
+    std::atomic<long> catchUps{0};
+    long watermarkEvents = 0;
+    std::chrono::nanoseconds watermarkDelay{0};
 };
 } // namespace disruptor
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sequence.h"
+
+namespace disruptor
+{
+
+/**
+ * Checkpoint file layout (host byte order), one page or more:
+ *   header: "DCKP" | uint32 version | uint32 maxSlots | uint32 slotCount
+ *   slot  : char name[48] | int64 value | int64 reserved   (64 bytes)
+ *
+ * Values are aligned 8-byte words updated with single atomic stores, so a
+ * reader (or a restart after a crash) sees either the old or the new value.
+ */
+struct CheckpointHeader
+{
+    char magic[4] = {'D', 'C', 'K', 'P'};
+    uint32_t version = 1;
+    uint32_t maxSlots = 0;
+    uint32_t slotCount = 0;
+};
+
+struct CheckpointSlot
+{
+    char name[48] = {};
+    int64_t value = Sequence::INITIAL_VALUE;
+    int64_t reserved = 0;
+};
+
+static_assert(sizeof(CheckpointSlot) == 64, "CheckpointSlot must be 64 bytes");
+
+/**
+ * Periodically persists consumer and gating sequences to a small mmap'd file.
+ *
+ * Typical restart with a journal (at-least-once):
+ *
+ *   SequenceCheckpoint checkpoint("/var/lib/app/sequences.ckp");
+ *   checkpoint.restore("matcher", processor.getSequence());
+ *   ringBuffer.resetTo(processor.getSequence().get());
+ *   checkpoint.track("matcher", processor.getSequence());
+ *   checkpoint.start();
+ *   // run processors, then replay the journal from processor.getSequence().get() + 1
+ *
+ * The hot path is untouched: the checkpoint thread reads the tracked
+ * Sequences. A checkpoint may trail the processor, so events after it are
+ * processed again on restart. An msync failure is sticky: the checkpoint
+ * thread stops, and checkpointNow() and stop() rethrow it.
+ */
+class SequenceCheckpoint
+{
+public:
+    explicit SequenceCheckpoint(const std::string& path,
+                                std::chrono::milliseconds interval = std::chrono::milliseconds(100),
+                                bool syncToDisk = true, uint32_t maxSlots = 64)
+        : path_(path), interval_(interval), syncToDisk_(syncToDisk)
+    {
+        if (maxSlots < 1)
+        {
+            throw std::invalid_argument("maxSlots must be >= 1");
+        }
+        int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw std::runtime_error("cannot open checkpoint file " + path + ": " + std::strerror(errno));
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("cannot stat checkpoint file " + path + ": " + std::strerror(errno));
+        }
+
+        bool fresh = st.st_size == 0;
+        if (!fresh)
+        {
+            CheckpointHeader existing;
+            if (::pread(fd, &existing, sizeof(existing), 0) != static_cast<ssize_t>(sizeof(existing)) ||
+                std::memcmp(existing.magic, CheckpointHeader{}.magic, sizeof(existing.magic)) != 0 ||
+                existing.version != CheckpointHeader{}.version || existing.slotCount > existing.maxSlots)
+            {
+                ::close(fd);
+                throw std::runtime_error("not a checkpoint file: " + path);
+            }
+            maxSlots = existing.maxSlots;
+        }
+
+        bytes_ = sizeof(CheckpointHeader) + sizeof(CheckpointSlot) * maxSlots;
+        if (!fresh && st.st_size < static_cast<off_t>(bytes_))
+        {
+            // Touching a slot past the end of the file would raise SIGBUS.
+            ::close(fd);
+            throw std::runtime_error("checkpoint file is truncated: " + path);
+        }
+        if (fresh && ::ftruncate(fd, static_cast<off_t>(bytes_)) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("cannot size checkpoint file " + path + ": " + std::strerror(errno));
+        }
+        void* base = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED)
+        {
+            throw std::runtime_error("cannot map checkpoint file " + path + ": " + std::strerror(errno));
+        }
+        base_ = static_cast<char*>(base);
+
+        if (fresh)
+        {
+            CheckpointHeader header;
+            header.maxSlots = maxSlots;
+            std::memcpy(base_, &header, sizeof(header));
+            if (::msync(base_, bytes_, MS_SYNC) != 0)
+            {
+                int error = errno;
+                ::munmap(base_, bytes_);
+                throw std::runtime_error("msync of checkpoint file failed: " + std::string(std::strerror(error)));
+            }
+        }
+    }
+
+    virtual ~SequenceCheckpoint()
+    {
+        stopThread();
+        if (base_ != nullptr)
+        {
+            ::munmap(base_, bytes_);
+        }
+    }
+
+    SequenceCheckpoint(const SequenceCheckpoint&) = delete;
+    SequenceCheckpoint& operator=(const SequenceCheckpoint&) = delete;
+
+    /**
+     * Set sequence to its checkpointed value. Returns false (leaving it
+     * untouched) if the name has never been checkpointed.
+     */
+    bool restore(const std::string& name, Sequence& sequence) const
+    {
+        const CheckpointSlot* slot = findSlot(name);
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        sequence.set(load(*slot));
+        return true;
+    }
+
+    /**
+     * Last checkpointed value for name, or Sequence::INITIAL_VALUE.
+     */
+    long getCheckpoint(const std::string& name) const
+    {
+        const CheckpointSlot* slot = findSlot(name);
+        return slot == nullptr ? Sequence::INITIAL_VALUE : load(*slot);
+    }
+
+    /**
+     * Persist sequence under name from now on. Call before start().
+     */
+    void track(const std::string& name, Sequence& sequence)
+    {
+        if (name.empty() || name.size() >= sizeof(CheckpointSlot::name))
+        {
+            throw std::invalid_argument("checkpoint name must be 1..47 characters");
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        CheckpointSlot* slot = findSlot(name);
+        if (slot == nullptr)
+        {
+            CheckpointHeader& h = header();
+            if (h.slotCount >= h.maxSlots)
+            {
+                throw std::length_error("checkpoint file is full: " + path_);
+            }
+            slot = &slots()[h.slotCount];
+            std::memcpy(slot->name, name.c_str(), name.size() + 1);
+            store(*slot, sequence.get());
+            // Publish the slot only once its name and value are in place.
+            std::atomic_ref<uint32_t>(h.slotCount).store(h.slotCount + 1, std::memory_order_release);
+        }
+        tracked_.emplace_back(slot, &sequence);
+    }
+
+    /**
+     * Copy every tracked sequence into the file and (optionally) msync it.
+     * Throws if this or any earlier msync failed.
+     */
+    void checkpointNow()
+    {
+        throwIfSyncFailed();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& [slot, sequence] : tracked_)
+        {
+            store(*slot, sequence->get());
+        }
+        if (syncToDisk_)
+        {
+            sync();
+        }
+    }
+
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        if (thread_.joinable())
+        {
+            return;
+        }
+        stopping_ = false;
+        thread_ = std::thread([this] { runLoop(); });
+    }
+
+    /**
+     * Stop the checkpoint thread after writing a final checkpoint. Throws if
+     * an msync failed, on this thread or the checkpoint thread.
+     */
+    void stop()
+    {
+        stopThread();
+        throwIfSyncFailed();
+    }
+
+protected:
+    /**
+     * msync(MS_SYNC) of the mapping, returning 0 or -1 with errno set. Override
+     * to route or fault-inject syncs; a subclass must stop() in its own
+     * destructor, since the checkpoint thread calls this.
+     */
+    virtual int syncMapping(void* address, size_t length) { return ::msync(address, length, MS_SYNC); }
+
+private:
+    void stopThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(threadMutex_);
+            if (!thread_.joinable())
+            {
+                return;
+            }
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    CheckpointHeader& header() const { return *reinterpret_cast<CheckpointHeader*>(base_); }
+    CheckpointSlot* slots() const { return reinterpret_cast<CheckpointSlot*>(base_ + sizeof(CheckpointHeader)); }
+
+    CheckpointSlot* findSlot(const std::string& name) const
+    {
+        uint32_t count = std::atomic_ref<uint32_t>(header().slotCount).load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (std::strncmp(slots()[i].name, name.c_str(), sizeof(CheckpointSlot::name)) == 0)
+            {
+                return &slots()[i];
+            }
+        }
+        return nullptr;
+    }
+
+    static long load(const CheckpointSlot& slot)
+    {
+        return static_cast<long>(
+            std::atomic_ref<int64_t>(const_cast<int64_t&>(slot.value)).load(std::memory_order_acquire));
+    }
+
+    static void store(CheckpointSlot& slot, long value)
+    {
+        std::atomic_ref<int64_t>(slot.value).store(value, std::memory_order_release);
+    }
+
+    void sync()
+    {
+        if (syncMapping(base_, bytes_) != 0)
+        {
+            recordSyncFailure(errno);
+            throwIfSyncFailed();
+        }
+    }
+
+    void recordSyncFailure(int error)
+    {
+        int expected = 0;
+        syncErrno_.compare_exchange_strong(expected, error, std::memory_order_acq_rel);
+    }
+
+    void throwIfSyncFailed()
+    {
+        if (int error = syncErrno_.load(std::memory_order_acquire); error != 0)
+        {
+            throw std::runtime_error("msync of checkpoint file failed: " + std::string(std::strerror(error)));
+        }
+    }
+
+    void runLoop()
+    {
+        std::unique_lock<std::mutex> lock(threadMutex_);
+        while (!stopping_)
+        {
+            cv_.wait_for(lock, interval_, [this] { return stopping_; });
+            lock.unlock();
+            try
+            {
+                checkpointNow();
+            }
+            catch (...)
+            {
+                // The failure is recorded; stop() rethrows it on the caller.
+                return;
+            }
+            lock.lock();
+        }
+    }
+
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    bool syncToDisk_;
+    char* base_ = nullptr;
+    size_t bytes_ = 0;
+
+    std::mutex mutex_;
+    std::vector<std::pair<CheckpointSlot*, Sequence*>> tracked_;
+
+    std::mutex threadMutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::thread thread_;
+    std::atomic<int> syncErrno_{0};  // first msync failure; sticky
+};
+
+} // namespace disruptor
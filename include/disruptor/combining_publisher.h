@@ -0,0 +1,264 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cache_line_storage.h"
+#include "ring_buffer.h"
+#include "wait_strategy.h"
+
+namespace disruptor
+{
+
+/**
+ * Flat-combining front end for many low-rate producers.
+ *
+ * With dozens of threads each publishing a single event now and then, every
+ * publish is an RMW on the shared multi-producer cursor and the cursor line
+ * bounces between cores. Here each producer writes its event into its own
+ * request slot and one of the waiting producers becomes the combiner: it
+ * collects every posted request, claims them all with one next(n), copies
+ * them into the ring, publishes the range and hands each requester its
+ * sequence. Contention on the cursor becomes one RMW per combining pass.
+ *
+ *   CombiningPublisher<Event> publisher(ringBuffer, 64);
+ *   // on each producer thread:
+ *   auto producer = publisher.producer();
+ *   long seq = producer.publish([&](Event& e) { e.value = ...; });
+ *
+ * publish() returns once the event is published. Each Producer is owned by one
+ * thread; its events keep their order. A Producer holds its request slot
+ * until it is destroyed, after which producer() hands the slot out again.
+ * Events are handed to the ring by copy (trivially copyable T) or swap, so T
+ * must be default constructible. Works on single- and multi-producer rings,
+ * as long as nothing else publishes to a single-producer ring.
+ */
+template <typename T>
+class CombiningPublisher
+{
+    struct alignas(CACHE_LINE_SIZE * 2) Request
+    {
+        std::atomic<int> state{EMPTY};
+        long sequence = Sequence::INITIAL_VALUE;
+        T event{};
+    };
+
+public:
+    class Producer
+    {
+    public:
+        Producer(Producer&& other) noexcept
+            : owner_(std::exchange(other.owner_, nullptr)), index_(other.index_)
+        {
+        }
+
+        Producer& operator=(Producer&& other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                owner_ = std::exchange(other.owner_, nullptr);
+                index_ = other.index_;
+            }
+            return *this;
+        }
+
+        Producer(const Producer&) = delete;
+        Producer& operator=(const Producer&) = delete;
+
+        ~Producer() { release(); }
+
+        /**
+         * Fill an event with fill(T&) and publish it through the combiner.
+         * Returns the sequence it was published at.
+         */
+        template <typename Fill>
+        long publish(Fill&& fill)
+        {
+            Request& request = owner_->requests_[index_];
+            std::forward<Fill>(fill)(request.event);
+            request.state.store(POSTED, std::memory_order_release);
+
+            int spins = SPIN_TRIES;
+            while (request.state.load(std::memory_order_acquire) != DONE)
+            {
+                if (owner_->tryCombine())
+                {
+                    continue;
+                }
+                if (--spins > 0)
+                {
+                    DISRUPTOR_CPU_PAUSE();
+                }
+                else
+                {
+                    std::this_thread::yield();
+                    spins = SPIN_TRIES;
+                }
+            }
+            request.state.store(EMPTY, std::memory_order_relaxed);
+            return request.sequence;
+        }
+
+    private:
+        friend class CombiningPublisher;
+
+        Producer(CombiningPublisher& owner, size_t index) : owner_(&owner), index_(index) {}
+
+        void release()
+        {
+            if (owner_ != nullptr)
+            {
+                owner_->releaseSlot(index_);
+                owner_ = nullptr;
+            }
+        }
+
+        CombiningPublisher* owner_;
+        size_t index_;
+    };
+
+    /**
+     * @param maxProducers  request slots, i.e. live Producers; at most the buffer size
+     */
+    CombiningPublisher(RingBuffer<T>& ringBuffer, int maxProducers)
+        : ringBuffer_(ringBuffer), maxProducers_(maxProducers)
+    {
+        if (maxProducers < 1 || maxProducers > ringBuffer.getBufferSize())
+        {
+            throw std::invalid_argument("maxProducers must be > 0 and <= bufferSize");
+        }
+        requests_ = std::make_unique<Request[]>(static_cast<size_t>(maxProducers));
+        occupied_ = std::make_unique<std::atomic<uint64_t>[]>(wordCount());
+        freeSlots_.reserve(static_cast<size_t>(maxProducers));
+        for (int i = maxProducers - 1; i >= 0; --i)
+        {
+            freeSlots_.push_back(static_cast<size_t>(i));
+        }
+        batch_.reserve(static_cast<size_t>(maxProducers));
+    }
+
+    CombiningPublisher(const CombiningPublisher&) = delete;
+    CombiningPublisher& operator=(const CombiningPublisher&) = delete;
+
+    /**
+     * Take a request slot for the calling thread; the slot is returned when
+     * the Producer is destroyed. Throws std::out_of_range while maxProducers
+     * Producers are alive.
+     */
+    Producer producer()
+    {
+        std::lock_guard<std::mutex> lock(slotsMutex_);
+        if (freeSlots_.empty())
+        {
+            throw std::out_of_range("CombiningPublisher: all producer slots are taken");
+        }
+        const size_t index = freeSlots_.back();
+        freeSlots_.pop_back();
+        occupied_[index / 64].fetch_or(uint64_t(1) << (index % 64), std::memory_order_release);
+        return Producer(*this, index);
+    }
+
+    /** Combining passes that published at least one event. */
+    long getCombineCount() const { return combines_.load(std::memory_order_relaxed); }
+
+    /** Events published through the combiner. */
+    long getPublishedCount() const { return published_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int EMPTY = 0;
+    static constexpr int POSTED = 1;
+    static constexpr int DONE = 2;
+    static constexpr int SPIN_TRIES = 100;
+
+    size_t wordCount() const { return (static_cast<size_t>(maxProducers_) + 63) / 64; }
+
+    void releaseSlot(size_t index)
+    {
+        std::lock_guard<std::mutex> lock(slotsMutex_);
+        occupied_[index / 64].fetch_and(~(uint64_t(1) << (index % 64)), std::memory_order_release);
+        freeSlots_.push_back(index);
+    }
+
+    /**
+     * Run one combining pass if nobody else is. Returns false if another
+     * thread holds the combiner role.
+     */
+    bool tryCombine()
+    {
+        if (combining_.load(std::memory_order_relaxed) || combining_.exchange(true, std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        batch_.clear();
+        const size_t words = wordCount();
+        for (size_t w = 0; w < words; ++w)
+        {
+            uint64_t bits = occupied_[w].load(std::memory_order_acquire);
+            while (bits != 0)
+            {
+                Request& request = requests_[w * 64 + static_cast<size_t>(__builtin_ctzll(bits))];
+                bits &= bits - 1;
+                if (request.state.load(std::memory_order_acquire) == POSTED)
+                {
+                    batch_.push_back(&request);
+                }
+            }
+        }
+
+        if (!batch_.empty())
+        {
+            const int n = static_cast<int>(batch_.size());
+            const long hi = ringBuffer_.next(n);
+            const long lo = hi - n + 1;
+            for (int i = 0; i < n; ++i)
+            {
+                Request& request = *batch_[static_cast<size_t>(i)];
+                T& slot = ringBuffer_.get(lo + i);
+                if constexpr (std::is_trivially_copyable_v<T>)
+                {
+                    slot = request.event;
+                }
+                else
+                {
+                    using std::swap;
+                    swap(slot, request.event);
+                }
+                request.sequence = lo + i;
+            }
+            ringBuffer_.publish(lo, hi);
+            for (Request* request : batch_)
+            {
+                request->state.store(DONE, std::memory_order_release);
+            }
+            // Only the combiner writes these, so no RMW is needed.
+            combines_.store(combines_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            published_.store(published_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+
+        combining_.store(false, std::memory_order_release);
+        return true;
+    }
+
+    RingBuffer<T>& ringBuffer_;
+    int maxProducers_;
+    std::unique_ptr<Request[]> requests_;
+    std::unique_ptr<std::atomic<uint64_t>[]> occupied_;  // one bit per live Producer
+    std::mutex slotsMutex_;
+    std::vector<size_t> freeSlots_;  // guarded by slotsMutex_
+
+    alignas(CACHE_LINE_SIZE * 2) std::atomic<bool> combining_{false};
+    std::vector<Request*> batch_;  // guarded by combining_
+    std::atomic<long> combines_{0};
+    std::atomic<long> published_{0};
+};
+
+} // namespace disruptor
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "exceptions.h"
+#include "ring_buffer.h"
+
+namespace disruptor
+{
+
+/**
+ * Batch publishing for multi-producer rings.
+ *
+ * BatchPublisher claims a whole batch up front, which on a multi-producer
+ * ring is only safe if every claimed slot gets published: a claimed but
+ * unpublished slot hides every later event, from every producer, until it
+ * is. Here each producer thread takes its own Handle, and both of its flows
+ * claim exactly what they publish with one next(n) and publish it with one
+ * publish(lo, hi), which sets the availability flags as one or two fills.
+ *
+ *   ConcurrentBatchPublisher<Event> publisher(ringBuffer, 64);
+ *   // on each producer thread:
+ *   auto handle = publisher.handle();
+ *
+ *   // Staged: events are built off-ring, then claimed and published together.
+ *   handle.claim().value = ...;   // publishes the stage when it is full
+ *   handle.publishBatch();         // the remainder
+ *
+ *   // In place: claim n slots, fill all of them, publish.
+ *   handle.beginBatch(n);
+ *   for (int i = 0; i < n; ++i) handle.getEvent(i).value = ...;
+ *   handle.endBatch();
+ *
+ * Staged events are handed to the ring by copy (trivially copyable T) or
+ * swap, so T must be default constructible. A Handle belongs to one thread;
+ * the publisher itself is shared.
+ */
+template <typename T>
+class ConcurrentBatchPublisher
+{
+public:
+    class Handle
+    {
+    public:
+        Handle(Handle&&) noexcept = default;
+        Handle& operator=(Handle&&) noexcept = default;
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+
+        // ============ Staged flow ============
+
+        /**
+         * Next staging slot. A full stage is published first.
+         */
+        T& claim()
+        {
+            if (isFull())
+            {
+                publishBatch();
+            }
+            return staged_[static_cast<size_t>(stagedCount_++)];
+        }
+
+        bool isFull() const { return stagedCount_ >= static_cast<int>(staged_.size()); }
+
+        /**
+         * Claim exactly the staged count, hand the events over and publish them.
+         */
+        void publishBatch()
+        {
+            if (stagedCount_ == 0)
+            {
+                return;
+            }
+            const long hi = ringBuffer_->next(stagedCount_);
+            transfer(hi - stagedCount_ + 1);
+            ringBuffer_->publish(hi - stagedCount_ + 1, hi);
+            countBatch(stagedCount_);
+            stagedCount_ = 0;
+        }
+
+        /**
+         * Like publishBatch() but never blocks: returns false, keeping the
+         * staged events, if the ring lacks room for all of them.
+         */
+        bool tryPublishBatch()
+        {
+            if (stagedCount_ == 0)
+            {
+                return true;
+            }
+            try
+            {
+                const long hi = ringBuffer_->tryNext(stagedCount_);
+                transfer(hi - stagedCount_ + 1);
+                ringBuffer_->publish(hi - stagedCount_ + 1, hi);
+            }
+            catch (const InsufficientCapacityException&)
+            {
+                return false;
+            }
+            countBatch(stagedCount_);
+            stagedCount_ = 0;
+            return true;
+        }
+
+        int getStagedCount() const { return stagedCount_; }
+
+        // ============ In-place flow ============
+
+        /**
+         * Claim size slots; every one must be filled before endBatch().
+         */
+        void beginBatch(int size)
+        {
+            highSequence_ = ringBuffer_->next(size);
+            lowSequence_ = highSequence_ - size + 1;
+        }
+
+        bool tryBeginBatch(int size)
+        {
+            try
+            {
+                highSequence_ = ringBuffer_->tryNext(size);
+                lowSequence_ = highSequence_ - size + 1;
+                return true;
+            }
+            catch (const InsufficientCapacityException&)
+            {
+                return false;
+            }
+        }
+
+        T& getEvent(int index) { return ringBuffer_->get(lowSequence_ + index); }
+        long getSequence(int index) const { return lowSequence_ + index; }
+
+        void endBatch()
+        {
+            ringBuffer_->publish(lowSequence_, highSequence_);
+            countBatch(static_cast<int>(highSequence_ - lowSequence_ + 1));
+        }
+
+        // ============ Accessors ============
+
+        long getPublishedCount() const { return published_; }
+        long getBatchCount() const { return batches_; }
+
+    private:
+        friend class ConcurrentBatchPublisher;
+
+        Handle(RingBuffer<T>& ringBuffer, int batchSize)
+            : ringBuffer_(&ringBuffer), staged_(static_cast<size_t>(batchSize))
+        {
+        }
+
+        void transfer(long lo)
+        {
+            for (int i = 0; i < stagedCount_; ++i)
+            {
+                T& slot = ringBuffer_->get(lo + i);
+                if constexpr (std::is_trivially_copyable_v<T>)
+                {
+                    slot = staged_[static_cast<size_t>(i)];
+                }
+                else
+                {
+                    // Swapping leaves the slot's old resources here for reuse.
+                    using std::swap;
+                    swap(slot, staged_[static_cast<size_t>(i)]);
+                }
+            }
+        }
+
+        void countBatch(int count)
+        {
+            published_ += count;
+            ++batches_;
+        }
+
+        RingBuffer<T>* ringBuffer_;
+        std::vector<T> staged_;
+        int stagedCount_ = 0;
+        long lowSequence_ = 0;
+        long highSequence_ = -1;
+        long published_ = 0;
+        long batches_ = 0;
+    };
+
+    /**
+     * @param batchSize  staged events per Handle; at most the buffer size
+     */
+    explicit ConcurrentBatchPublisher(RingBuffer<T>& ringBuffer, int batchSize = 100)
+        : ringBuffer_(ringBuffer), batchSize_(std::max(1, std::min(batchSize, ringBuffer.getBufferSize())))
+    {
+    }
+
+    /**
+     * A new handle for the calling thread.
+     */
+    Handle handle() { return Handle(ringBuffer_, batchSize_); }
+
+    int getBatchSize() const { return batchSize_; }
+
+private:
+    RingBuffer<T>& ringBuffer_;
+    int batchSize_;
+};
+
+} // namespace disruptor
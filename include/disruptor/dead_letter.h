@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "NanoLogCpp17.h"
+#include "event_handler.h"
+#include "exception_handler.h"
+#include "exceptions.h"
+#include "ring_buffer.h"
+
+namespace disruptor
+{
+
+/**
+ * Slot type of a dead-letter ring: a copy of the failed event plus retry state.
+ */
+template <typename T>
+struct DeadLetter
+{
+    T event{};
+    long sequence = -1;  // sequence of the event in the main ring
+    int attempts = 0;    // failed attempts so far, the original failure included
+    std::string error;   // message of the most recent failure
+};
+
+/**
+ * Exponential backoff between attempts, bounded by maxAttempts in total.
+ */
+struct RetryPolicy
+{
+    int maxAttempts = 3;
+    std::chrono::nanoseconds initialBackoff = std::chrono::milliseconds(1);
+    double multiplier = 2.0;
+    std::chrono::nanoseconds maxBackoff = std::chrono::seconds(1);
+
+    /**
+     * Delay before the next attempt, given the number of failed attempts so far.
+     */
+    std::chrono::nanoseconds backoffAfter(int attempts) const
+    {
+        double delay = static_cast<double>(initialBackoff.count());
+        for (int i = 1; i < attempts && delay < static_cast<double>(maxBackoff.count()); ++i)
+        {
+            delay *= multiplier;
+        }
+        return std::min(std::chrono::nanoseconds(static_cast<long>(delay)), maxBackoff);
+    }
+};
+
+/**
+ * Exception handler that copies the failing event into a dead-letter ring and
+ * lets the processor continue with the next event.
+ *
+ * When the dead-letter ring is full the event is dropped and counted, so the
+ * main stage never waits on failure handling; pass blockWhenFull = true to
+ * apply backpressure instead. With several publishing processors (a
+ * WorkerPool) the dead-letter ring must be multi-producer. Lifecycle
+ * exceptions go to the fallback handler.
+ */
+template <typename T>
+class DeadLetterExceptionHandler final : public ExceptionHandler<T>
+{
+public:
+    explicit DeadLetterExceptionHandler(RingBuffer<DeadLetter<T>>& deadLetters, bool blockWhenFull = false,
+                                        ExceptionHandler<T>& fallback = ExceptionHandlers<T>::defaultHandler())
+        : deadLetters_(deadLetters), blockWhenFull_(blockWhenFull), fallback_(fallback)
+    {
+    }
+
+    void handleEventException(std::exception_ptr exception, long sequence, T* event) override
+    {
+        if (event == nullptr)
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        long slot;
+        if (blockWhenFull_)
+        {
+            slot = deadLetters_.next();
+        }
+        else
+        {
+            try
+            {
+                slot = deadLetters_.tryNext();
+            }
+            catch (const InsufficientCapacityException&)
+            {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+        }
+
+        DeadLetter<T>& letter = deadLetters_.get(slot);
+        letter.event = *event;
+        letter.sequence = sequence;
+        letter.attempts = 1;
+        letter.error = detail::exceptionMessage(exception);
+        deadLetters_.publish(slot);
+        deadLettered_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void handleOnStartException(std::exception_ptr exception) override
+    {
+        fallback_.handleOnStartException(exception);
+    }
+
+    void handleOnShutdownException(std::exception_ptr exception) override
+    {
+        fallback_.handleOnShutdownException(exception);
+    }
+
+    long getDeadLetteredCount() const { return deadLettered_.load(std::memory_order_relaxed); }
+    long getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    RingBuffer<DeadLetter<T>>& deadLetters_;
+    bool blockWhenFull_;
+    ExceptionHandler<T>& fallback_;
+
+    std::atomic<long> deadLettered_{0};
+    std::atomic<long> dropped_{0};
+};
+
+/**
+ * Consumer of the dead-letter ring: retries each event with backoff until it
+ * succeeds or reaches maxAttempts, then hands it to onExhausted (or logs it).
+ *
+ * Backoff sleeps on this consumer's thread, which only delays later dead
+ * letters; the main stage is unaffected unless the dead-letter ring fills.
+ */
+template <typename T>
+class DeadLetterRetryHandler final : public EventHandler<DeadLetter<T>>
+{
+public:
+    /** Reprocess the event; throw to signal another failure. */
+    using Retry = std::function<void(T& event, long sequence)>;
+    using Exhausted = std::function<void(DeadLetter<T>& letter)>;
+
+    explicit DeadLetterRetryHandler(Retry retry, RetryPolicy policy = {}, Exhausted onExhausted = {})
+        : retry_(std::move(retry)), policy_(policy), onExhausted_(std::move(onExhausted))
+    {
+    }
+
+    void onEvent(DeadLetter<T>& letter, long, bool) override
+    {
+        while (letter.attempts < policy_.maxAttempts)
+        {
+            std::this_thread::sleep_for(policy_.backoffAfter(letter.attempts));
+            retries_.fetch_add(1, std::memory_order_relaxed);
+            try
+            {
+                retry_(letter.event, letter.sequence);
+                recovered_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            catch (...)
+            {
+                letter.error = detail::exceptionMessage(std::current_exception());
+                ++letter.attempts;
+            }
+        }
+
+        exhausted_.fetch_add(1, std::memory_order_relaxed);
+        if (onExhausted_)
+        {
+            onExhausted_(letter);
+        }
+        else
+        {
+            NANO_LOG(WARNING, "Dead letter exhausted after %d attempts: sequence %ld: %s", letter.attempts,
+                     letter.sequence, letter.error.c_str());
+        }
+    }
+
+    long getRetryCount() const { return retries_.load(std::memory_order_relaxed); }
+    long getRecoveredCount() const { return recovered_.load(std::memory_order_relaxed); }
+    long getExhaustedCount() const { return exhausted_.load(std::memory_order_relaxed); }
+
+private:
+    Retry retry_;
+    RetryPolicy policy_;
+    Exhausted onExhausted_;
+
+    std::atomic<long> retries_{0};
+    std::atomic<long> recovered_{0};
+    std::atomic<long> exhausted_{0};
+};
+
+} // namespace disruptor
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "event_handler.h"
+#include "ring_buffer.h"
+#include "wait_strategy.h"
+
+namespace disruptor
+{
+
+/**
+ * Binary capture file layout (host byte order):
+ *   header: "DCAP" | uint32 version | uint32 sizeof(T) | uint32 reserved
+ *   record: int64 captureNanos | T (raw bytes), repeated
+ */
+struct EventCaptureHeader
+{
+    char magic[4] = {'D', 'C', 'A', 'P'};
+    uint32_t version = 1;
+    uint32_t recordSize = 0;
+    uint32_t reserved = 0;
+};
+
+namespace detail
+{
+inline long long captureNowNanos()
+{
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+}
+
+/**
+ * EventHandler that records every event with its capture timestamp.
+ * Records are staged in a local buffer and written when it fills and at shutdown,
+ * so the consumer thread only pays for a memcpy per event.
+ */
+template <typename T>
+class EventCaptureHandler final : public EventHandler<T>
+{
+    static_assert(std::is_trivially_copyable_v<T>, "EventCaptureHandler requires a trivially copyable event type");
+
+public:
+    static constexpr size_t RECORD_SIZE = sizeof(int64_t) + sizeof(T);
+
+    explicit EventCaptureHandler(const std::string& path, size_t bufferBytes = 1 << 20)
+        : file_(std::fopen(path.c_str(), "wb"))
+    {
+        if (file_ == nullptr)
+        {
+            throw std::runtime_error("cannot open capture file: " + path);
+        }
+        EventCaptureHeader header;
+        header.recordSize = static_cast<uint32_t>(sizeof(T));
+        if (std::fwrite(&header, sizeof(header), 1, file_) != 1)
+        {
+            std::fclose(file_);
+            throw std::runtime_error("cannot write capture header: " + path);
+        }
+        buffer_.resize(std::max(bufferBytes, RECORD_SIZE));
+    }
+
+    ~EventCaptureHandler() override
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    EventCaptureHandler(const EventCaptureHandler&) = delete;
+    EventCaptureHandler& operator=(const EventCaptureHandler&) = delete;
+
+    void onEvent(T& event, long, bool) override
+    {
+        if (used_ + RECORD_SIZE > buffer_.size())
+        {
+            flush();
+        }
+        int64_t now = detail::captureNowNanos();
+        char* out = buffer_.data() + used_;
+        std::memcpy(out, &now, sizeof(now));
+        std::memcpy(out + sizeof(now), &event, sizeof(T));
+        used_ += RECORD_SIZE;
+        ++captured_;
+    }
+
+    void onShutdown() override
+    {
+        flush();
+        std::fflush(file_);
+    }
+
+    /**
+     * Write staged records to the file. Safe to call from the consumer thread only.
+     */
+    void flush()
+    {
+        if (used_ > 0 && file_ != nullptr)
+        {
+            if (std::fwrite(buffer_.data(), 1, used_, file_) != used_)
+            {
+                throw std::runtime_error("short write to capture file");
+            }
+            used_ = 0;
+        }
+    }
+
+    void close()
+    {
+        if (file_ != nullptr)
+        {
+            bool written = used_ == 0 || std::fwrite(buffer_.data(), 1, used_, file_) == used_;
+            used_ = 0;
+            std::fclose(file_);
+            file_ = nullptr;
+            if (!written)
+            {
+                throw std::runtime_error("short write to capture file");
+            }
+        }
+    }
+
+    long getCapturedCount() const { return captured_; }
+
+private:
+    std::FILE* file_;
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    long captured_ = 0;
+};
+
+/**
+ * Republishes a capture file into a RingBuffer.
+ *
+ * speed == 0   : as fast as possible, using batched claims of up to batchSize
+ * speed == 1.0 : original inter-event timing
+ * speed == k   : timing compressed k times (0.5 = half speed)
+ *
+ * In timed mode all records that are already due are claimed and published as
+ * one batch, so a replay that falls behind catches up the way a real burst would.
+ */
+template <typename T>
+class EventReplayer
+{
+    static_assert(std::is_trivially_copyable_v<T>, "EventReplayer requires a trivially copyable event type");
+
+public:
+    static constexpr size_t RECORD_SIZE = sizeof(int64_t) + sizeof(T);
+
+    explicit EventReplayer(const std::string& path)
+        : file_(std::fopen(path.c_str(), "rb"))
+    {
+        if (file_ == nullptr)
+        {
+            throw std::runtime_error("cannot open capture file: " + path);
+        }
+        EventCaptureHeader header;
+        EventCaptureHeader expected;
+        if (std::fread(&header, sizeof(header), 1, file_) != 1 ||
+            std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+            header.version != expected.version)
+        {
+            std::fclose(file_);
+            throw std::runtime_error("not a capture file: " + path);
+        }
+        if (header.recordSize != sizeof(T))
+        {
+            std::fclose(file_);
+            throw std::runtime_error("capture record size does not match event type: " + path);
+        }
+    }
+
+    ~EventReplayer()
+    {
+        if (file_ != nullptr)
+        {
+            std::fclose(file_);
+        }
+    }
+
+    EventReplayer(const EventReplayer&) = delete;
+    EventReplayer& operator=(const EventReplayer&) = delete;
+
+    /**
+     * Replay the remaining records. Returns the number of events published.
+     */
+    long replay(RingBuffer<T>& ringBuffer, double speed = 1.0, int batchSize = 256)
+    {
+        batchSize = std::max(1, std::min(batchSize, ringBuffer.getBufferSize()));
+        std::vector<char> chunk(RECORD_SIZE * static_cast<size_t>(batchSize));
+
+        long published = 0;
+        bool haveOrigin = false;
+        int64_t firstCapture = 0;
+        long long replayStart = 0;
+
+        size_t n;
+        while ((n = std::fread(chunk.data(), RECORD_SIZE, static_cast<size_t>(batchSize), file_)) > 0)
+        {
+            size_t i = 0;
+            while (i < n)
+            {
+                size_t end = n;
+                if (speed > 0.0)
+                {
+                    if (!haveOrigin)
+                    {
+                        firstCapture = captureTime(chunk, i);
+                        replayStart = detail::captureNowNanos();
+                        haveOrigin = true;
+                    }
+                    auto dueAt = [&](size_t r) {
+                        return replayStart +
+                            static_cast<long long>(static_cast<double>(captureTime(chunk, r) - firstCapture) / speed);
+                    };
+                    while (detail::captureNowNanos() < dueAt(i))
+                    {
+                        DISRUPTOR_CPU_PAUSE();
+                    }
+                    long long now = detail::captureNowNanos();
+                    end = i + 1;
+                    while (end < n && dueAt(end) <= now)
+                    {
+                        ++end;
+                    }
+                }
+
+                int count = static_cast<int>(end - i);
+                long hi = ringBuffer.next(count);
+                long lo = hi - count + 1;
+                for (int k = 0; k < count; ++k)
+                {
+                    std::memcpy(&ringBuffer.get(lo + k), chunk.data() + (i + k) * RECORD_SIZE + sizeof(int64_t), sizeof(T));
+                }
+                ringBuffer.publish(lo, hi);
+                published += count;
+                i = end;
+            }
+        }
+        return published;
+    }
+
+private:
+    static int64_t captureTime(const std::vector<char>& chunk, size_t record)
+    {
+        int64_t ts;
+        std::memcpy(&ts, chunk.data() + record * RECORD_SIZE, sizeof(ts));
+        return ts;
+    }
+
+    std::FILE* file_;
+};
+
+} // namespace disruptor
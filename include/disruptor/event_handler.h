@@ -2,10 +2,37 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
 #include <mutex>
 
 namespace disruptor
 {
+/**
+ * A run of published events [first(), last()] still sitting in the ring,
+ * handed to EventHandler::onCatchUp.
+ */
+template <typename T>
+class EventRange
+{
+public:
+    EventRange(T* entries, size_t indexMask, long first, long last)
+        : entries_(entries), indexMask_(indexMask), first_(first), last_(last)
+    {
+    }
+
+    T& operator[](long sequence) const { return entries_[static_cast<size_t>(sequence) & indexMask_]; }
+
+    long first() const { return first_; }
+    long last() const { return last_; }
+    long size() const { return last_ - first_ + 1; }
+
+private:
+    T* entries_;
+    size_t indexMask_;
+    long first_;
+    long last_;
+};
+
 /**
  * Standard event handler - processes events one at a time.
  */
@@ -32,6 +59,29 @@ public:
      * Called when the processor shuts down.
      */
     virtual void onShutdown() {}
+
+    /**
+     * Called after the processor was evicted as a slow consumer: events
+     * [firstSkipped, lastSkipped] were never delivered and processing resumes
+     * at lastSkipped + 1.
+     */
+    virtual void onLapped(long /*firstSkipped*/, long /*lastSkipped*/) {}
+
+    /**
+     * Called before each batch once the processor has a catch-up threshold
+     * (BatchEventProcessor::setCatchUpThreshold): [lo, hi] is the batch and
+     * lag is how many published events are outstanding (cursor - lo + 1).
+     */
+    virtual void onBatchStart(long /*lo*/, long /*hi*/, long /*lag*/) {}
+
+    /**
+     * Called instead of onEvent when a batch reaches the catch-up threshold,
+     * e.g. to rebuild an aggregate from the newest events only. Return true if
+     * the whole backlog was consumed; false delivers it through onEvent as usual.
+     * If it throws, the exception handler sees the range's first sequence and
+     * processing continues with the next one.
+     */
+    virtual bool onCatchUp(EventRange<T>& /*backlog*/) { return false; }
 };
 
 /**
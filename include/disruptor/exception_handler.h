@@ -1,8 +1,20 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
+
+#include <execinfo.h>
 
 #include "NanoLogCpp17.h"
 #include "backward.hpp"
@@ -14,18 +26,67 @@ using NanoLog::LogLevels::WARNING;
 
 namespace detail
 {
-inline std::string buildStackTrace()
+/**
+ * Return addresses captured with backtrace(): no symbol lookup, no allocation.
+ */
+struct RawStackTrace
+{
+    static constexpr int MAX_FRAMES = 32;
+
+    void* frames[MAX_FRAMES];
+    int size = 0;
+
+    void capture()
+    {
+        size = ::backtrace(frames, MAX_FRAMES);
+    }
+
+    uint64_t hash() const
+    {
+        uint64_t h = 1469598103934665603ULL;
+        for (int i = 0; i < size; ++i)
+        {
+            h = (h ^ reinterpret_cast<uintptr_t>(frames[i])) * 1099511628211ULL;
+        }
+        return h;
+    }
+};
+
+/**
+ * Resolve captured addresses through backward-cpp. This is the expensive part
+ * (debug info lookup), so it belongs off the consumer thread.
+ */
+inline std::string symbolize(const RawStackTrace& stack)
 {
-    backward::StackTrace stackTrace;
-    stackTrace.load_here(64);
-    backward::Printer printer;
-    printer.object = true;
-    printer.color_mode = backward::ColorMode::automatic;
+    backward::TraceResolver resolver;
+    resolver.load_addresses(stack.frames, stack.size);
     std::ostringstream out;
-    printer.print(stackTrace, out);
+    for (int i = 0; i < stack.size; ++i)
+    {
+        backward::ResolvedTrace trace =
+            resolver.resolve(backward::ResolvedTrace(backward::Trace(stack.frames[i], static_cast<size_t>(i))));
+        out << "#" << i << " " << trace.addr << " in "
+            << (trace.source.function.empty() ? trace.object_function : trace.source.function);
+        if (!trace.source.filename.empty())
+        {
+            out << " at " << trace.source.filename << ":" << trace.source.line;
+        }
+        else if (!trace.object_filename.empty())
+        {
+            out << " from " << trace.object_filename;
+        }
+        out << "\n";
+    }
     return out.str();
 }
 
+inline std::string buildStackTrace()
+{
+    RawStackTrace stack;
+    stack.capture();
+    return symbolize(stack);
+}
+
 inline std::string exceptionMessage(std::exception_ptr exception)
 {
     if (!exception)
@@ -46,6 +107,201 @@ inline std::string exceptionMessage(std::exception_ptr exception)
         return "non-std exception";
     }
 }
+
+/**
+ * Deduplicating, rate-limited exception logger.
+ *
+ * report() runs on the failing consumer thread and only captures raw return
+ * addresses, formats the exception message and queues a record. A reporter
+ * thread (started on first use) symbolizes and logs. A failure with the same
+ * context, message and stack as one already logged within the window is only
+ * counted; the next report of that signature after the window carries the
+ * repeat count. At most maxReportsPerWindow records are queued per window
+ * across all signatures; the rest are counted as suppressed too.
+ */
+class ExceptionReporter
+{
+public:
+    explicit ExceptionReporter(std::chrono::nanoseconds window = std::chrono::seconds(1),
+                               uint32_t maxReportsPerWindow = 16, size_t queueCapacity = 64)
+        : window_(window), maxReportsPerWindow_(maxReportsPerWindow), queueCapacity_(queueCapacity)
+    {
+    }
+
+    ~ExceptionReporter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (worker_.joinable())
+        {
+            worker_.join();
+        }
+        for (auto& [key, signature] : signatures_)
+        {
+            if (signature.suppressed > 0)
+            {
+                NANO_LOG(WARNING, "%s: %s (repeated %ld more times, not logged)", signature.context,
+                         signature.message.c_str(), signature.suppressed);
+            }
+        }
+    }
+
+    ExceptionReporter(const ExceptionReporter&) = delete;
+    ExceptionReporter& operator=(const ExceptionReporter&) = delete;
+
+    void report(bool error, const char* context, std::exception_ptr exception, long sequence, const void* event)
+    {
+        Record record;
+        record.stack.capture();
+        record.error = error;
+        record.context = context;
+        record.message = exceptionMessage(exception);
+        record.sequence = sequence;
+        record.event = event;
+
+        const uint64_t key = record.stack.hash() ^ std::hash<std::string>{}(record.message) ^
+                             reinterpret_cast<uintptr_t>(context);
+        const auto now = std::chrono::steady_clock::now();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (now >= windowEnd_)
+        {
+            windowEnd_ = now + window_;
+            reportsInWindow_ = 0;
+            if (signatures_.size() > MAX_SIGNATURES)
+            {
+                pruneExpired(now);
+            }
+        }
+
+        Signature& signature = signatures_[key];
+        if (now < signature.windowEnd || reportsInWindow_ >= maxReportsPerWindow_ || queue_.size() >= queueCapacity_)
+        {
+            if (signature.message.empty())
+            {
+                signature.context = context;
+                signature.message = record.message;
+            }
+            ++signature.suppressed;
+            suppressed_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        record.repeats = signature.suppressed;
+        signature.context = context;
+        signature.message = record.message;
+        signature.suppressed = 0;
+        signature.windowEnd = now + window_;
+        ++reportsInWindow_;
+
+        queue_.push_back(std::move(record));
+        if (!worker_.joinable())
+        {
+            worker_ = std::thread([this] { drainLoop(); });
+        }
+        wake_.notify_one();
+    }
+
+    /**
+     * Block until every queued record has been logged.
+     */
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return queue_.empty() && !busy_; });
+    }
+
+    long getReportedCount() const { return reported_.load(std::memory_order_relaxed); }
+    long getSuppressedCount() const { return suppressed_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t MAX_SIGNATURES = 1024;
+
+    struct Record
+    {
+        RawStackTrace stack;
+        bool error = false;
+        const char* context = "";
+        std::string message;
+        long sequence = -1;
+        const void* event = nullptr;
+        long repeats = 0;
+    };
+
+    struct Signature
+    {
+        std::chrono::steady_clock::time_point windowEnd{};
+        const char* context = "";
+        std::string message;
+        long suppressed = 0;
+    };
+
+    void pruneExpired(std::chrono::steady_clock::time_point now)
+    {
+        for (auto it = signatures_.begin(); it != signatures_.end();)
+        {
+            it = (it->second.suppressed == 0 && now >= it->second.windowEnd) ? signatures_.erase(it) : std::next(it);
+        }
+    }
+
+    void drainLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty())
+            {
+                return;
+            }
+            Record record = std::move(queue_.front());
+            queue_.pop_front();
+            busy_ = true;
+            lock.unlock();
+
+            const std::string stack = symbolize(record.stack);
+            if (record.error)
+            {
+                NANO_LOG(ERROR, "%s: %s\nSequence: %ld\nEvent: %p\nRepeated: %ld\nStack:\n%s", record.context,
+                         record.message.c_str(), record.sequence, record.event, record.repeats, stack.c_str());
+            }
+            else
+            {
+                NANO_LOG(WARNING, "%s: %s\nSequence: %ld\nEvent: %p\nRepeated: %ld\nStack:\n%s", record.context,
+                         record.message.c_str(), record.sequence, record.event, record.repeats, stack.c_str());
+            }
+            reported_.fetch_add(1, std::memory_order_relaxed);
+
+            lock.lock();
+            busy_ = false;
+            if (queue_.empty())
+            {
+                idle_.notify_all();
+            }
+        }
+    }
+
+    const std::chrono::nanoseconds window_;
+    const uint32_t maxReportsPerWindow_;
+    const size_t queueCapacity_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<Record> queue_;
+    std::unordered_map<uint64_t, Signature> signatures_;
+    std::chrono::steady_clock::time_point windowEnd_{};
+    uint32_t reportsInWindow_ = 0;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::thread worker_;
+
+    std::atomic<long> reported_{0};
+    std::atomic<long> suppressed_{0};
+};
 }
 
 template <typename T>
@@ -58,6 +314,10 @@ public:
     virtual void handleOnShutdownException(std::exception_ptr exception) = 0;
 };
 
+/**
+ * Logs and rethrows, stopping the processor. Symbolizes synchronously: it runs
+ * once per processor and the process may exit before a reporter thread would.
+ */
 template <typename T>
 class FatalExceptionHandler final : public ExceptionHandler<T>
 {
@@ -89,34 +349,46 @@ private:
     }
 };
 
+/**
+ * Logs and continues. The consumer thread only pays for a raw stack capture;
+ * symbolization, deduplication and rate limiting happen in a reporter thread,
+ * so a burst of bad events does not stall the pipeline.
+ */
 template <typename T>
 class IgnoreExceptionHandler final : public ExceptionHandler<T>
 {
 public:
+    explicit IgnoreExceptionHandler(std::chrono::nanoseconds window = std::chrono::seconds(1),
+                                    uint32_t maxReportsPerWindow = 16)
+        : reporter_(window, maxReportsPerWindow)
+    {
+    }
+
     void handleEventException(std::exception_ptr exception, long sequence, T* event) override
     {
-        logException("Exception processing", exception, sequence, event);
+        reporter_.report(false, "Exception processing", exception, sequence, event);
     }
 
     void handleOnStartException(std::exception_ptr exception) override
     {
-        logException("Exception during onStart()", exception, -1, nullptr);
+        reporter_.report(false, "Exception during onStart()", exception, -1, nullptr);
     }
 
     void handleOnShutdownException(std::exception_ptr exception) override
     {
-        logException("Exception during onShutdown()", exception, -1, nullptr);
+        reporter_.report(false, "Exception during onShutdown()", exception, -1, nullptr);
     }
 
+    /**
+     * Wait until queued reports have been logged.
+     */
+    void flush() { reporter_.flush(); }
+
+    long getReportedCount() const { return reporter_.getReportedCount(); }
+    long getSuppressedCount() const { return reporter_.getSuppressedCount(); }
+
 private:
-    void logException(const char* context, std::exception_ptr exception, long sequence, T* event)
-    {
-        const std::string message = detail::exceptionMessage(exception);
-        const std::string stack = detail::buildStackTrace();
-        NANO_LOG(WARNING,
-            "%s: %s\nSequence: %ld\nEvent: %p\nStack:\n%s",
-            context, message.c_str(), sequence, static_cast<void*>(event), stack.c_str());
-    }
+    detail::ExceptionReporter reporter_;
 };
 
 template <typename T>
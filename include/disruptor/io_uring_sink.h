@@ -0,0 +1,519 @@
+#pragma once
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+
+#define DISRUPTOR_HAS_IO_URING 1
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "event_handler.h"
+#include "ring_buffer.h"
+#include "sequence.h"
+#include "wait_strategy.h"
+
+namespace disruptor
+{
+
+namespace detail
+{
+/**
+ * Minimal io_uring wrapper over the raw syscalls (no liburing dependency).
+ * One thread fills and submits SQEs; any thread may reap CQEs.
+ */
+class IoUring
+{
+public:
+    explicit IoUring(unsigned entries)
+    {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0)
+        {
+            throw std::runtime_error(std::string("io_uring_setup failed: ") + std::strerror(errno));
+        }
+
+        sqRingBytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingBytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMmap)
+        {
+            sqRingBytes_ = cqRingBytes_ = std::max(sqRingBytes_, cqRingBytes_);
+        }
+
+        sqRing_ = map(sqRingBytes_, IORING_OFF_SQ_RING);
+        cqRing_ = singleMmap ? sqRing_ : map(cqRingBytes_, IORING_OFF_CQ_RING);
+        sqesBytes_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqesBytes_, IORING_OFF_SQES));
+
+        char* sq = static_cast<char*>(sqRing_);
+        sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqEntries_ = params.sq_entries;
+        sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+        char* cq = static_cast<char*>(cqRing_);
+        cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        localTail_ = *sqTail_;
+    }
+
+    ~IoUring()
+    {
+        if (sqes_ != nullptr)
+        {
+            ::munmap(sqes_, sqesBytes_);
+        }
+        if (cqRing_ != nullptr && cqRing_ != sqRing_)
+        {
+            ::munmap(cqRing_, cqRingBytes_);
+        }
+        if (sqRing_ != nullptr)
+        {
+            ::munmap(sqRing_, sqRingBytes_);
+        }
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+    }
+
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    /**
+     * Register fixed buffers. Returns false if the kernel refuses (e.g. memlock limit).
+     */
+    bool registerBuffers(const iovec* buffers, unsigned count)
+    {
+        return ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, buffers, count) == 0;
+    }
+
+    /**
+     * Next free SQE, zeroed, or nullptr if the submission queue is full.
+     */
+    io_uring_sqe* getSqe()
+    {
+        unsigned head = std::atomic_ref<unsigned>(*sqHead_).load(std::memory_order_acquire);
+        if (localTail_ - head >= sqEntries_)
+        {
+            return nullptr;
+        }
+        unsigned index = localTail_ & sqMask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqArray_[index] = index;
+        ++localTail_;
+        return sqe;
+    }
+
+    /**
+     * Publish queued SQEs to the kernel and enter it once.
+     */
+    void submit()
+    {
+        unsigned tail = *sqTail_;
+        unsigned pending = localTail_ - tail;
+        if (pending == 0)
+        {
+            return;
+        }
+        std::atomic_ref<unsigned>(*sqTail_).store(localTail_, std::memory_order_release);
+        while (pending > 0)
+        {
+            long rc = ::syscall(__NR_io_uring_enter, fd_, pending, 0, 0, nullptr, 0);
+            if (rc < 0)
+            {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+                {
+                    continue;
+                }
+                throw std::runtime_error(std::string("io_uring_enter failed: ") + std::strerror(errno));
+            }
+            pending -= static_cast<unsigned>(rc);
+        }
+    }
+
+    /**
+     * Block until at least one completion is available.
+     */
+    void waitCompletion()
+    {
+        while (::syscall(__NR_io_uring_enter, fd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0)
+        {
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {
+                throw std::runtime_error(std::string("io_uring_enter failed: ") + std::strerror(errno));
+            }
+        }
+    }
+
+    /**
+     * Invoke f(cqe) for every available completion. Returns the number reaped.
+     */
+    template <typename F>
+    unsigned reap(F&& f)
+    {
+        unsigned head = *cqHead_;
+        unsigned tail = std::atomic_ref<unsigned>(*cqTail_).load(std::memory_order_acquire);
+        unsigned count = 0;
+        for (; head != tail; ++head, ++count)
+        {
+            f(cqes_[head & cqMask_]);
+        }
+        std::atomic_ref<unsigned>(*cqHead_).store(head, std::memory_order_release);
+        return count;
+    }
+
+private:
+    void* map(size_t bytes, off_t offset)
+    {
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+        if (p == MAP_FAILED)
+        {
+            throw std::runtime_error(std::string("io_uring mmap failed: ") + std::strerror(errno));
+        }
+        return p;
+    }
+
+    int fd_ = -1;
+    void* sqRing_ = nullptr;
+    void* cqRing_ = nullptr;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sqRingBytes_ = 0;
+    size_t cqRingBytes_ = 0;
+    size_t sqesBytes_ = 0;
+
+    unsigned* sqHead_ = nullptr;
+    unsigned* sqTail_ = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned sqMask_ = 0;
+    unsigned sqEntries_ = 0;
+    unsigned localTail_ = 0;
+
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+}
+
+/**
+ * File sink that writes each batch straight from the ring's slots via io_uring.
+ *
+ * The ring's entry array is registered once as a fixed buffer; at endOfBatch
+ * the batch's slots (split in two at the wrap point) are submitted as
+ * WRITE_FIXED requests and onEvent returns without waiting for the disk. A
+ * completion thread retires writes in order and advances getCompletedSequence(),
+ * which producers must gate on instead of the processor's sequence so slots are
+ * not overwritten while the kernel still reads them:
+ *
+ *   ringBuffer.addGatingSequences({&sink.getCompletedSequence()});
+ *
+ * Records are the raw bytes of T, appended in sequence order. A failed write is
+ * sticky: getCompletedSequence() stops before it, no further batches are
+ * submitted, and the error is rethrown on the handler thread at every later
+ * batch and at shutdown.
+ */
+template <typename T>
+class IoUringFileSink final : public EventHandler<T>
+{
+    static_assert(std::is_trivially_copyable_v<T>, "IoUringFileSink requires a trivially copyable event type");
+
+public:
+    IoUringFileSink(RingBuffer<T>& ringBuffer, const std::string& path, unsigned queueDepth = 64,
+                    bool syncOnShutdown = true)
+        : ringBuffer_(ringBuffer),
+          queueDepth_(std::max(1u, queueDepth)),
+          syncOnShutdown_(syncOnShutdown),
+          ops_(std::make_unique<Op[]>(queueDepth_)),
+          uring_(queueDepth_ + 1)
+    {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0)
+        {
+            throw std::runtime_error("cannot open sink file " + path + ": " + std::strerror(errno));
+        }
+        iovec slots{ringBuffer_.getEntries(), sizeof(T) * static_cast<size_t>(ringBuffer_.getBufferSize())};
+        fixedBuffers_ = uring_.registerBuffers(&slots, 1);
+    }
+
+    ~IoUringFileSink() override
+    {
+        try
+        {
+            stopReaper();
+        }
+        catch (...)
+        {
+        }
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+        }
+    }
+
+    IoUringFileSink(const IoUringFileSink&) = delete;
+    IoUringFileSink& operator=(const IoUringFileSink&) = delete;
+
+    void onStart() override
+    {
+        if (!reaper_.joinable())
+        {
+            reaper_ = std::thread([this] { reapLoop(); });
+        }
+    }
+
+    void onEvent(T&, long sequence, bool endOfBatch) override
+    {
+        if (batchStart_ < 0)
+        {
+            batchStart_ = sequence;
+        }
+        lastSeen_ = sequence;
+        if (endOfBatch)
+        {
+            long lo = batchStart_;
+            batchStart_ = -1;
+            throwIfFailed();
+            submitRange(lo, sequence);
+            throwIfFailed();
+        }
+    }
+
+    void onShutdown() override
+    {
+        if (batchStart_ >= 0 && error_.load(std::memory_order_acquire) == 0)
+        {
+            // Halted mid-batch: write what was handed to us so far.
+            submitRange(batchStart_, lastSeen_);
+        }
+        batchStart_ = -1;
+        while (retired_.load(std::memory_order_acquire) < submitted_)
+        {
+            std::this_thread::yield();
+        }
+        stopReaper();
+        throwIfFailed();
+        if (syncOnShutdown_ && ::fdatasync(fd_) != 0)
+        {
+            throw std::runtime_error(std::string("fdatasync failed: ") + std::strerror(errno));
+        }
+    }
+
+    /**
+     * Highest sequence whose bytes have been written (completion received).
+     */
+    Sequence& getCompletedSequence() { return completedSequence_; }
+
+    /**
+     * True when the ring's slots are registered as a fixed buffer
+     * (false falls back to plain IORING_OP_WRITE).
+     */
+    bool usesFixedBuffers() const { return fixedBuffers_; }
+
+private:
+    static constexpr uint64_t STOP_TOKEN = ~uint64_t(0);
+
+    struct Op
+    {
+        long hi = 0;
+        const char* addr = nullptr;
+        size_t len = 0;
+        uint64_t offset = 0;
+        bool done = false;    // reaper thread only
+        bool failed = false;  // reaper thread only
+    };
+
+    void submitRange(long lo, long hi)
+    {
+        const long size = ringBuffer_.getBufferSize();
+        long first = std::min(hi, lo + (size - static_cast<long>(ringBuffer_.getIndex(lo))) - 1);
+        queueWrite(lo, first);
+        if (first < hi)
+        {
+            queueWrite(first + 1, hi);
+        }
+        uring_.submit();
+    }
+
+    void queueWrite(long lo, long hi)
+    {
+        while (submitted_ - retired_.load(std::memory_order_acquire) >= static_cast<long>(queueDepth_))
+        {
+            // All ops in flight: flush what is queued and wait for the reaper.
+            uring_.submit();
+            DISRUPTOR_CPU_PAUSE();
+        }
+        long k = submitted_;
+        Op& op = ops_[static_cast<size_t>(k % queueDepth_)];
+        op.hi = hi;
+        op.addr = reinterpret_cast<const char*>(ringBuffer_.getPointer(lo));
+        op.len = sizeof(T) * static_cast<size_t>(hi - lo + 1);
+        op.offset = fileOffset_;
+        op.done = false;
+        op.failed = false;
+        fileOffset_ += op.len;
+
+        io_uring_sqe* sqe = uring_.getSqe();
+        while (sqe == nullptr)
+        {
+            uring_.submit();
+            sqe = uring_.getSqe();
+        }
+        sqe->opcode = fixedBuffers_ ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe->fd = fd_;
+        sqe->addr = reinterpret_cast<uint64_t>(op.addr);
+        sqe->len = static_cast<uint32_t>(op.len);
+        sqe->off = op.offset;
+        sqe->buf_index = 0;
+        sqe->user_data = static_cast<uint64_t>(k);
+
+        // Release the op fields to the reaper before the kernel can complete it.
+        submittedShared_.store(k + 1, std::memory_order_release);
+        submitted_ = k + 1;
+    }
+
+    void reapLoop()
+    {
+        bool stopping = false;
+        while (!stopping)
+        {
+            uring_.waitCompletion();
+            long visible = submittedShared_.load(std::memory_order_acquire);
+            uring_.reap([&](const io_uring_cqe& cqe) {
+                if (cqe.user_data == STOP_TOKEN)
+                {
+                    stopping = true;
+                    return;
+                }
+                long k = static_cast<long>(cqe.user_data);
+                if (k >= visible)
+                {
+                    visible = submittedShared_.load(std::memory_order_acquire);
+                }
+                complete(ops_[static_cast<size_t>(k % queueDepth_)], cqe.res);
+            });
+
+            long retired = retired_.load(std::memory_order_relaxed);
+            while (retired < visible && ops_[static_cast<size_t>(retired % queueDepth_)].done)
+            {
+                // Ops are still retired after a failure, to free their slots, but the
+                // completed sequence never moves past the first failed write.
+                Op& op = ops_[static_cast<size_t>(retired % queueDepth_)];
+                writeFailed_ = writeFailed_ || op.failed;
+                if (!writeFailed_)
+                {
+                    completedSequence_.set(op.hi);
+                }
+                ++retired;
+            }
+            retired_.store(retired, std::memory_order_release);
+        }
+    }
+
+    void complete(Op& op, int res)
+    {
+        if (res < 0)
+        {
+            recordError(-res);
+            op.failed = true;
+        }
+        else if (static_cast<size_t>(res) < op.len)
+        {
+            // Short write (rare for regular files): finish it synchronously.
+            size_t written = static_cast<size_t>(res);
+            while (written < op.len)
+            {
+                ssize_t n = ::pwrite(fd_, op.addr + written, op.len - written, static_cast<off_t>(op.offset + written));
+                if (n <= 0)
+                {
+                    recordError(n < 0 ? errno : EIO);
+                    op.failed = true;
+                    break;
+                }
+                written += static_cast<size_t>(n);
+            }
+        }
+        op.done = true;
+    }
+
+    void recordError(int error)
+    {
+        int expected = 0;
+        error_.compare_exchange_strong(expected, error, std::memory_order_release);
+    }
+
+    void throwIfFailed()
+    {
+        if (int error = error_.load(std::memory_order_acquire); error != 0)
+        {
+            throw std::runtime_error(std::string("io_uring write failed: ") + std::strerror(error));
+        }
+    }
+
+    void stopReaper()
+    {
+        if (!reaper_.joinable())
+        {
+            return;
+        }
+        io_uring_sqe* sqe = uring_.getSqe();
+        while (sqe == nullptr)
+        {
+            uring_.submit();
+            sqe = uring_.getSqe();
+        }
+        sqe->opcode = IORING_OP_NOP;
+        sqe->user_data = STOP_TOKEN;
+        uring_.submit();
+        reaper_.join();
+    }
+
+    RingBuffer<T>& ringBuffer_;
+    unsigned queueDepth_;
+    bool syncOnShutdown_;
+    std::unique_ptr<Op[]> ops_;
+    detail::IoUring uring_;
+    int fd_ = -1;
+    bool fixedBuffers_ = false;
+
+    // Handler thread.
+    long batchStart_ = -1;
+    long lastSeen_ = -1;
+    long submitted_ = 0;
+    uint64_t fileOffset_ = 0;
+
+    std::atomic<long> submittedShared_{0};
+    std::atomic<long> retired_{0};
+    std::atomic<int> error_{0};  // first write failure; sticky
+    std::thread reaper_;
+    bool writeFailed_ = false;  // reaper thread only
+
+    Sequence completedSequence_{Sequence::INITIAL_VALUE};
+};
+
+} // namespace disruptor
+
+#endif
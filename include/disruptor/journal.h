@@ -0,0 +1,589 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "event_handler.h"
+#include "ring_buffer.h"
+#include "sequence.h"
+
+namespace disruptor
+{
+
+/**
+ * Journal segment layout (host byte order):
+ *   page 0 : JournalSegmentHeader
+ *   page 1+: capacity fixed-size records; record i holds sequence firstSequence + i
+ *
+ * committedCount is advanced at each endOfBatch, so a reader never sees a
+ * partially written batch. Files are named <prefix>.<firstSequence:020>.jnl.
+ */
+struct JournalSegmentHeader
+{
+    char magic[4] = {'D', 'J', 'N', 'L'};
+    uint32_t version = 1;
+    uint32_t recordSize = 0;
+    uint32_t reserved = 0;
+    int64_t firstSequence = 0;
+    int64_t capacity = 0;
+    int64_t committedCount = 0;
+};
+
+inline constexpr size_t JOURNAL_HEADER_BYTES = 4096;
+
+/**
+ * Default record codec: the event's raw bytes.
+ * Flyweight events supply their own codec with the same three members.
+ */
+template <typename T>
+struct RawJournalCodec
+{
+    static_assert(std::is_trivially_copyable_v<T>, "RawJournalCodec requires a trivially copyable event type");
+
+    static constexpr size_t RECORD_SIZE = sizeof(T);
+
+    static void encode(const T& event, char* out) { std::memcpy(out, &event, sizeof(T)); }
+    static void decode(const char* in, T& event) { std::memcpy(&event, in, sizeof(T)); }
+};
+
+enum class JournalDurability
+{
+    None,              // written to the page cache only
+    MsyncPerBatch,     // msync(MS_SYNC) of the batch's pages at every endOfBatch
+    FdatasyncInterval  // group commit: a flusher thread fdatasyncs committed batches every interval
+};
+
+struct JournalConfig
+{
+    std::string directory;
+    std::string prefix = "journal";
+    long segmentRecords = 1 << 20;
+    JournalDurability durability = JournalDurability::None;
+    std::chrono::milliseconds syncInterval{10};
+
+    /** Syncs a segment fd; ::fdatasync unless overridden (e.g. to inject failures in tests). */
+    std::function<int(int)> syncFile = ::fdatasync;
+};
+
+namespace detail
+{
+inline std::string journalSegmentPath(const std::string& directory, const std::string& prefix, long firstSequence)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "%020ld", firstSequence);
+    return (std::filesystem::path(directory) / (prefix + "." + name + ".jnl")).string();
+}
+
+inline std::runtime_error journalError(const std::string& what, const std::string& path)
+{
+    return std::runtime_error(what + " failed for " + path + ": " + std::strerror(errno));
+}
+}
+
+/**
+ * Append-only journaling stage.
+ *
+ * Each event is encoded into a pre-allocated, memory-mapped segment; a full
+ * segment is synced, unmapped and replaced by the next one. A batch is
+ * committed at endOfBatch, and getDurableSequence() only advances past events
+ * that are persisted under the configured policy, so downstream consumers can
+ * gate on it:
+ *
+ *   auto barrier = ringBuffer.newBarrier({&journal.getDurableSequence()});
+ *
+ * FdatasyncInterval runs a flusher thread between onStart() and onShutdown()
+ * rather than syncing inline, so the durable sequence still catches up when the
+ * producer pauses (or is itself gated on durable consumers).
+ *
+ * A failed sync is sticky: Linux reports a writeback error only once per fd, so
+ * a later successful sync proves nothing about the pages that were lost. After
+ * the first failure the durable sequence never advances again, and the error
+ * is rethrown on the handler thread at every commit and from onShutdown().
+ */
+template <typename T, typename Codec = RawJournalCodec<T>>
+class JournalHandler final : public EventHandler<T>
+{
+public:
+    explicit JournalHandler(JournalConfig config) : config_(std::move(config))
+    {
+        if (config_.segmentRecords < 1)
+        {
+            throw std::invalid_argument("segmentRecords must be >= 1");
+        }
+        std::filesystem::create_directories(config_.directory);
+    }
+
+    ~JournalHandler() override
+    {
+        stopFlusher();
+        try
+        {
+            closeSegment();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    JournalHandler(const JournalHandler&) = delete;
+    JournalHandler& operator=(const JournalHandler&) = delete;
+
+    void onEvent(T& event, long sequence, bool endOfBatch) override
+    {
+        if (base_ == nullptr || sequence != nextSequence_ || written_ == config_.segmentRecords)
+        {
+            rollTo(sequence);
+        }
+        Codec::encode(event, records_ + written_ * Codec::RECORD_SIZE);
+        ++written_;
+        nextSequence_ = sequence + 1;
+
+        if (endOfBatch)
+        {
+            commitBatch();
+        }
+    }
+
+    void onStart() override
+    {
+        if (config_.durability == JournalDurability::FdatasyncInterval && !flusher_.joinable())
+        {
+            stopping_ = false;
+            flusher_ = std::thread([this] { flushLoop(); });
+        }
+    }
+
+    void onShutdown() override
+    {
+        stopFlusher();
+        throwIfSyncFailed();
+        if (base_ != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(segmentMutex_);
+            header()->committedCount = written_;
+            syncSegment();
+        }
+    }
+
+    /**
+     * Highest sequence persisted under the configured durability policy.
+     */
+    Sequence& getDurableSequence() { return durableSequence_; }
+
+    const JournalConfig& getConfig() const { return config_; }
+
+private:
+    JournalSegmentHeader* header() { return reinterpret_cast<JournalSegmentHeader*>(base_); }
+
+    void rollTo(long firstSequence)
+    {
+        std::lock_guard<std::mutex> lock(segmentMutex_);
+        closeSegmentLocked();
+
+        const std::string path = detail::journalSegmentPath(config_.directory, config_.prefix, firstSequence);
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0)
+        {
+            throw detail::journalError("open", path);
+        }
+        mappedBytes_ = JOURNAL_HEADER_BYTES + static_cast<size_t>(config_.segmentRecords) * Codec::RECORD_SIZE;
+        // Reserve the blocks up front: a later ENOSPC on a mapped page is SIGBUS.
+        int rc = ::posix_fallocate(fd_, 0, static_cast<off_t>(mappedBytes_));
+        if (rc != 0)
+        {
+            errno = rc;
+            ::close(fd_);
+            fd_ = -1;
+            throw detail::journalError("posix_fallocate", path);
+        }
+        void* base = ::mmap(nullptr, mappedBytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (base == MAP_FAILED)
+        {
+            ::close(fd_);
+            fd_ = -1;
+            throw detail::journalError("mmap", path);
+        }
+        base_ = static_cast<char*>(base);
+        records_ = base_ + JOURNAL_HEADER_BYTES;
+        written_ = 0;
+        syncedCount_ = 0;
+        firstSequence_ = firstSequence;
+        nextSequence_ = firstSequence;
+
+        JournalSegmentHeader h;
+        h.recordSize = static_cast<uint32_t>(Codec::RECORD_SIZE);
+        h.firstSequence = firstSequence;
+        h.capacity = config_.segmentRecords;
+        std::memcpy(base_, &h, sizeof(h));
+    }
+
+    void commitBatch()
+    {
+        throwIfSyncFailed();
+        header()->committedCount = written_;
+        long committed = nextSequence_ - 1;
+        switch (config_.durability)
+        {
+        case JournalDurability::None:
+            durableSequence_.set(committed);
+            break;
+        case JournalDurability::MsyncPerBatch:
+            // Throws, leaving syncedCount_ and the durable sequence behind, if it fails.
+            msyncRange(syncedCount_, written_);
+            syncedCount_ = written_;
+            durableSequence_.set(committed);
+            break;
+        case JournalDurability::FdatasyncInterval:
+            committedSequence_.store(committed, std::memory_order_release);
+            break;
+        }
+    }
+
+    /**
+     * msync the pages holding records [from, to) plus the header page.
+     */
+    void msyncRange(long from, long to)
+    {
+        static const size_t pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        size_t begin = (JOURNAL_HEADER_BYTES + static_cast<size_t>(from) * Codec::RECORD_SIZE) & ~(pageSize - 1);
+        size_t end = JOURNAL_HEADER_BYTES + static_cast<size_t>(to) * Codec::RECORD_SIZE;
+        // A writeback error is reported only once, so a later msync may succeed
+        // over lost pages: the failure is sticky.
+        if ((end > begin && ::msync(base_ + begin, end - begin, MS_SYNC) != 0) ||
+            ::msync(base_, JOURNAL_HEADER_BYTES, MS_SYNC) != 0)
+        {
+            recordSyncFailure(errno, "msync");
+            throwIfSyncFailed();
+        }
+    }
+
+    /**
+     * Sync everything written to the current segment. Caller holds segmentMutex_.
+     */
+    void syncSegment()
+    {
+        throwIfSyncFailed();
+        if (config_.durability != JournalDurability::None && written_ > syncedCount_)
+        {
+            // On Linux, fdatasync also writes back dirty pages of shared mappings.
+            if (config_.syncFile(fd_) != 0)
+            {
+                recordSyncFailure(errno, "fdatasync");
+                throwIfSyncFailed();
+            }
+        }
+        syncedCount_ = written_;
+        if (written_ > 0)
+        {
+            durableSequence_.set(firstSequence_ + written_ - 1);
+        }
+    }
+
+    void flushLoop()
+    {
+        std::unique_lock<std::mutex> wait(flusherMutex_);
+        while (!stopping_)
+        {
+            flusherCv_.wait_for(wait, config_.syncInterval, [this] { return stopping_; });
+
+            std::lock_guard<std::mutex> lock(segmentMutex_);
+            long committed = committedSequence_.load(std::memory_order_acquire);
+            if (fd_ >= 0 && committed > durableSequence_.get() && syncErrno_.load(std::memory_order_acquire) == 0)
+            {
+                if (config_.syncFile(fd_) != 0)
+                {
+                    // The durable sequence stays put for good; the handler thread rethrows.
+                    recordSyncFailure(errno, "fdatasync");
+                    continue;
+                }
+                durableSequence_.set(committed);
+            }
+        }
+    }
+
+    void recordSyncFailure(int error, const char* call)
+    {
+        const char* noCall = nullptr;
+        syncCall_.compare_exchange_strong(noCall, call, std::memory_order_acq_rel);
+        int expected = 0;
+        syncErrno_.compare_exchange_strong(expected, error, std::memory_order_acq_rel);
+    }
+
+    void throwIfSyncFailed()
+    {
+        if (int error = syncErrno_.load(std::memory_order_acquire); error != 0)
+        {
+            throw std::runtime_error(std::string(syncCall_.load(std::memory_order_acquire)) + " failed: " +
+                                     std::strerror(error));
+        }
+    }
+
+    void stopFlusher()
+    {
+        if (flusher_.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(flusherMutex_);
+                stopping_ = true;
+            }
+            flusherCv_.notify_all();
+            flusher_.join();
+        }
+    }
+
+    void closeSegment()
+    {
+        std::lock_guard<std::mutex> lock(segmentMutex_);
+        closeSegmentLocked();
+    }
+
+    void closeSegmentLocked()
+    {
+        if (base_ == nullptr)
+        {
+            return;
+        }
+        header()->committedCount = written_;
+        std::exception_ptr syncError;
+        try
+        {
+            syncSegment();
+        }
+        catch (...)
+        {
+            syncError = std::current_exception();
+        }
+        ::munmap(base_, mappedBytes_);
+        ::close(fd_);
+        base_ = nullptr;
+        records_ = nullptr;
+        fd_ = -1;
+        if (syncError)
+        {
+            std::rethrow_exception(syncError);
+        }
+    }
+
+    JournalConfig config_;
+    int fd_ = -1;
+    char* base_ = nullptr;
+    char* records_ = nullptr;
+    size_t mappedBytes_ = 0;
+    long firstSequence_ = 0;
+    long nextSequence_ = 0;
+    long written_ = 0;
+    long syncedCount_ = 0;
+
+    // FdatasyncInterval: the consumer publishes committed batches, the flusher makes them durable.
+    std::atomic<long> committedSequence_{Sequence::INITIAL_VALUE};
+    std::mutex segmentMutex_;
+    std::mutex flusherMutex_;
+    std::condition_variable flusherCv_;
+    bool stopping_ = false;
+    std::thread flusher_;
+    std::atomic<const char*> syncCall_{nullptr};  // call that failed first
+    std::atomic<int> syncErrno_{0};               // first sync failure; sticky
+
+    Sequence durableSequence_{Sequence::INITIAL_VALUE};
+};
+
+/**
+ * Rebuilds a RingBuffer from journal segments.
+ *
+ * Segments are memory-mapped read-only and their committed records decoded
+ * straight into claimed slots, batchSize at a time, so recovery runs at memory
+ * bandwidth. Journal sequence s is published at ring sequence s; the replayer
+ * must be the ring's only publisher while it runs.
+ *
+ *   ringBuffer.resetTo(from - 1);
+ *   processor.getSequence().set(from - 1);
+ *   replayer.replay(ringBuffer, from);
+ */
+template <typename T, typename Codec = RawJournalCodec<T>>
+class JournalReplayer
+{
+public:
+    struct Segment
+    {
+        std::string path;
+        long firstSequence = 0;
+        long committedCount = 0;
+    };
+
+    explicit JournalReplayer(const std::string& directory, const std::string& prefix = "journal")
+    {
+        const std::string lead = prefix + ".";
+        for (const auto& entry : std::filesystem::directory_iterator(directory))
+        {
+            const std::string name = entry.path().filename().string();
+            if (name.size() != lead.size() + 20 + 4 || name.compare(0, lead.size(), lead) != 0 ||
+                name.compare(name.size() - 4, 4, ".jnl") != 0)
+            {
+                continue;
+            }
+            JournalSegmentHeader header = readHeader(entry.path().string());
+            segments_.push_back({entry.path().string(), static_cast<long>(header.firstSequence),
+                                 static_cast<long>(header.committedCount)});
+        }
+        std::sort(segments_.begin(), segments_.end(),
+                  [](const Segment& a, const Segment& b) { return a.firstSequence < b.firstSequence; });
+    }
+
+    const std::vector<Segment>& getSegments() const { return segments_; }
+
+    /**
+     * Last committed sequence in the journal, or -1 if it is empty.
+     */
+    long getLastSequence() const
+    {
+        for (auto it = segments_.rbegin(); it != segments_.rend(); ++it)
+        {
+            if (it->committedCount > 0)
+            {
+                return it->firstSequence + it->committedCount - 1;
+            }
+        }
+        return Sequence::INITIAL_VALUE;
+    }
+
+    /**
+     * Publish journal records [fromSequence, getLastSequence()] into the ring.
+     * The ring cursor must already be at fromSequence - 1 (see RingBuffer::resetTo).
+     * Returns the number of events published.
+     */
+    long replay(RingBuffer<T>& ringBuffer, long fromSequence, int batchSize = 1024)
+    {
+        if (ringBuffer.getCursor() != fromSequence - 1)
+        {
+            throw std::invalid_argument("ring cursor must be at fromSequence - 1; call RingBuffer::resetTo first");
+        }
+        long last = getLastSequence();
+        if (fromSequence > last + 1 || (!segments_.empty() && fromSequence < segments_.front().firstSequence))
+        {
+            throw std::out_of_range("fromSequence is not covered by the journal");
+        }
+        batchSize = std::max(1, std::min(batchSize, ringBuffer.getBufferSize()));
+
+        long next = fromSequence;
+        for (const auto& segment : segments_)
+        {
+            long segmentEnd = segment.firstSequence + segment.committedCount;
+            if (segmentEnd <= next)
+            {
+                continue;
+            }
+            if (segment.firstSequence > next)
+            {
+                throw std::runtime_error("journal gap before " + segment.path);
+            }
+            next = replaySegment(ringBuffer, segment, next, batchSize);
+        }
+        return next - fromSequence;
+    }
+
+private:
+    static JournalSegmentHeader readHeader(const std::string& path)
+    {
+        JournalSegmentHeader header;
+        JournalSegmentHeader expected;
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (f == nullptr)
+        {
+            throw detail::journalError("open", path);
+        }
+        struct stat st;
+        bool ok = ::fstat(::fileno(f), &st) == 0 && std::fread(&header, sizeof(header), 1, f) == 1;
+        std::fclose(f);
+        if (!ok || std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+            header.version != expected.version)
+        {
+            throw std::runtime_error("not a journal segment: " + path);
+        }
+        if (header.recordSize != Codec::RECORD_SIZE)
+        {
+            throw std::runtime_error("journal record size does not match codec: " + path);
+        }
+        if (header.committedCount < 0 || header.committedCount > header.capacity ||
+            !coversRecords(st.st_size, header.committedCount))
+        {
+            throw std::runtime_error("journal segment is truncated or corrupt: " + path);
+        }
+        return header;
+    }
+
+    /**
+     * True if a file of fileSize bytes holds the header and count records;
+     * mapping records past the end of the file would raise SIGBUS.
+     */
+    static bool coversRecords(off_t fileSize, long count)
+    {
+        return fileSize >= static_cast<off_t>(JOURNAL_HEADER_BYTES) &&
+               (static_cast<size_t>(fileSize) - JOURNAL_HEADER_BYTES) / Codec::RECORD_SIZE >= static_cast<size_t>(count);
+    }
+
+    static long replaySegment(RingBuffer<T>& ringBuffer, const Segment& segment, long next, int batchSize)
+    {
+        int fd = ::open(segment.path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw detail::journalError("open", segment.path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || !coversRecords(st.st_size, segment.committedCount))
+        {
+            ::close(fd);
+            throw std::runtime_error("journal segment is truncated or corrupt: " + segment.path);
+        }
+        size_t bytes = JOURNAL_HEADER_BYTES + static_cast<size_t>(segment.committedCount) * Codec::RECORD_SIZE;
+        void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED)
+        {
+            throw detail::journalError("mmap", segment.path);
+        }
+        ::madvise(base, bytes, MADV_SEQUENTIAL);
+
+        const char* records = static_cast<const char*>(base) + JOURNAL_HEADER_BYTES;
+        long end = segment.firstSequence + segment.committedCount;
+        while (next < end)
+        {
+            int count = static_cast<int>(std::min<long>(batchSize, end - next));
+            long hi = ringBuffer.next(count);
+            long lo = hi - count + 1;
+            for (int k = 0; k < count; ++k)
+            {
+                Codec::decode(records + static_cast<size_t>(next - segment.firstSequence + k) * Codec::RECORD_SIZE,
+                              ringBuffer.get(lo + k));
+            }
+            ringBuffer.publish(lo, hi);
+            next += count;
+        }
+
+        ::munmap(base, bytes);
+        return next;
+    }
+
+    std::vector<Segment> segments_;
+};
+
+} // namespace disruptor
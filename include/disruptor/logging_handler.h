@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "NanoLogCpp17.h"
+#include "event_handler.h"
+
+namespace disruptor
+{
+
+/**
+ * Per-type admission policy for LoggingHandler.
+ * sampleEvery = N logs one event in N; maxPerSecond = 0 means unlimited.
+ */
+struct LogSamplingPolicy
+{
+    uint32_t sampleEvery = 1;
+    uint32_t maxPerSecond = 0;
+};
+
+/**
+ * Audit/logging consumer stage backed by NanoLog.
+ *
+ * NANO_LOG needs a string-literal format to take its compile-time path, so the
+ * format lives in the caller's log function, which brings its own severity
+ * names into scope:
+ *
+ *   using NanoLog::LogLevels::NOTICE;
+ *   auto logger = makeLoggingHandler<Order>(
+ *       [](const Order& o, long seq) { NANO_LOG(NOTICE, "order %ld px=%ld qty=%d", seq, o.price, o.qty); },
+ *       [](const Order& o) { return static_cast<size_t>(o.type); }, 4);
+ *   logger.setPolicy(FILL, {1, 0});          // every fill
+ *   logger.setPolicy(QUOTE, {100, 10000});   // 1% of quotes, at most 10k/s
+ *
+ * Admission costs a couple of counter updates per event; the clock is read
+ * once per batch. Types outside [0, typeCount) share one extra bucket. At the
+ * end of each one-second window, a type that dropped events under its rate
+ * limit gets one summary line.
+ */
+template <typename T, typename LogFn, typename TypeFn>
+class LoggingHandler final : public EventHandler<T>
+{
+public:
+    LoggingHandler(LogFn log, TypeFn typeOf, size_t typeCount, LogSamplingPolicy defaultPolicy = {})
+        : log_(std::move(log)), typeOf_(std::move(typeOf)), buckets_(typeCount + 1)
+    {
+        for (auto& bucket : buckets_)
+        {
+            bucket.policy = sanitize(defaultPolicy);
+        }
+    }
+
+    /**
+     * Policy for one type; type == typeCount addresses the shared out-of-range bucket.
+     */
+    void setPolicy(size_t type, LogSamplingPolicy policy)
+    {
+        buckets_.at(type).policy = sanitize(policy);
+    }
+
+    void onEvent(T& event, long sequence, bool endOfBatch) override
+    {
+        if (newBatch_)
+        {
+            now_ = std::chrono::steady_clock::now();
+            newBatch_ = false;
+        }
+        newBatch_ = endOfBatch;
+
+        const size_t key = std::min(typeOf_(static_cast<const T&>(event)), buckets_.size() - 1);
+        Bucket& bucket = buckets_[key];
+
+        if (++bucket.seen < bucket.policy.sampleEvery)
+        {
+            ++sampledOut_;
+            return;
+        }
+        bucket.seen = 0;
+
+        if (bucket.policy.maxPerSecond > 0)
+        {
+            if (now_ >= bucket.windowEnd)
+            {
+                reportSuppressed(bucket, key);
+                bucket.windowEnd = now_ + std::chrono::seconds(1);
+                bucket.loggedInWindow = 0;
+            }
+            if (bucket.loggedInWindow >= bucket.policy.maxPerSecond)
+            {
+                ++bucket.suppressed;
+                ++rateLimited_;
+                return;
+            }
+            ++bucket.loggedInWindow;
+        }
+
+        log_(static_cast<const T&>(event), sequence);
+        ++logged_;
+    }
+
+    void onShutdown() override
+    {
+        for (size_t key = 0; key < buckets_.size(); ++key)
+        {
+            reportSuppressed(buckets_[key], key);
+        }
+        NanoLog::sync();
+    }
+
+    long getLoggedCount() const { return logged_; }
+    long getSampledOutCount() const { return sampledOut_; }
+    long getRateLimitedCount() const { return rateLimited_; }
+
+private:
+    struct Bucket
+    {
+        LogSamplingPolicy policy;
+        uint32_t seen = 0;
+        uint32_t loggedInWindow = 0;
+        long suppressed = 0;
+        std::chrono::steady_clock::time_point windowEnd{};
+    };
+
+    static LogSamplingPolicy sanitize(LogSamplingPolicy policy)
+    {
+        if (policy.sampleEvery == 0)
+        {
+            throw std::invalid_argument("sampleEvery must be >= 1");
+        }
+        return policy;
+    }
+
+    /**
+     * One summary line per bucket key: a type, or the shared out-of-range bucket.
+     */
+    void reportSuppressed(Bucket& bucket, size_t key) const
+    {
+        if (bucket.suppressed > 0)
+        {
+            if (key == buckets_.size() - 1)
+            {
+                NANO_LOG(NanoLog::LogLevels::NOTICE,
+                         "logging stage: rate limit dropped %ld events of out-of-range types", bucket.suppressed);
+            }
+            else
+            {
+                NANO_LOG(NanoLog::LogLevels::NOTICE, "logging stage: rate limit dropped %ld events of type %d",
+                         bucket.suppressed, static_cast<int>(key));
+            }
+            bucket.suppressed = 0;
+        }
+    }
+
+    LogFn log_;
+    TypeFn typeOf_;
+    std::vector<Bucket> buckets_;
+
+    bool newBatch_ = true;
+    std::chrono::steady_clock::time_point now_{};
+    long logged_ = 0;
+    long sampledOut_ = 0;
+    long rateLimited_ = 0;
+};
+
+/**
+ * Deduces the callable types: makeLoggingHandler<Event>(logFn, typeFn, typeCount).
+ */
+template <typename T, typename LogFn, typename TypeFn>
+LoggingHandler<T, LogFn, TypeFn> makeLoggingHandler(LogFn log, TypeFn typeOf, size_t typeCount,
+                                                    LogSamplingPolicy defaultPolicy = {})
+{
+    return LoggingHandler<T, LogFn, TypeFn>(std::move(log), std::move(typeOf), typeCount, defaultPolicy);
+}
+
+} // namespace disruptor
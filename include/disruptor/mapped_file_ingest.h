@@ -0,0 +1,254 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ring_buffer.h"
+#include "sequence.h"
+
+namespace disruptor
+{
+
+/**
+ * Backfill producer over a memory-mapped input file.
+ *
+ * The file is split into chunks at record delimiters. Chunks are parsed in
+ * parallel by worker threads, and the caller's thread publishes them strictly
+ * in file order through a BatchPublisher. The parser receives each record as a
+ * pointer into the mapping; events keep that slice rather than copying the
+ * payload, so the ingest object must outlive every consumer of its events.
+ *
+ * The mapping is advised MADV_SEQUENTIAL. If a release sequence is set (the
+ * slowest consumer's sequence), pages of chunks every consumer has passed are
+ * dropped with MADV_DONTNEED. Touching them again just faults them back in
+ * from the file.
+ */
+template <typename T>
+class MappedFileIngest
+{
+public:
+    /**
+     * Fill event from one record (without its delimiter). Return false to skip it.
+     * Called concurrently from worker threads.
+     */
+    using Parser = std::function<bool(const char* record, size_t length, T& event)>;
+
+    explicit MappedFileIngest(const std::string& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("cannot stat " + path + ": " + std::strerror(errno));
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0)
+        {
+            void* base = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (base == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("cannot map " + path + ": " + std::strerror(errno));
+            }
+            data_ = static_cast<const char*>(base);
+            ::madvise(base, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    ~MappedFileIngest()
+    {
+        if (data_ != nullptr)
+        {
+            ::munmap(const_cast<char*>(data_), size_);
+        }
+    }
+
+    MappedFileIngest(const MappedFileIngest&) = delete;
+    MappedFileIngest& operator=(const MappedFileIngest&) = delete;
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    /**
+     * Sequence of the slowest consumer; pages behind it are released.
+     */
+    void setReleaseSequence(Sequence* sequence) { releaseSequence_ = sequence; }
+
+    /**
+     * Parse and publish every record. Returns the number of events published.
+     *
+     * @param threads     parser threads (0 = hardware concurrency)
+     * @param chunkBytes  target chunk size; chunks end at the next delimiter
+     * @param batchSize   slots claimed per BatchPublisher batch
+     */
+    long publishAll(RingBuffer<T>& ringBuffer, const Parser& parser, int threads = 0, size_t chunkBytes = 4 << 20,
+                    int batchSize = 256, char delimiter = '\n')
+    {
+        if (threads <= 0)
+        {
+            threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+        batchSize = std::max(1, std::min(batchSize, ringBuffer.getBufferSize()));
+        chunkBytes = std::max<size_t>(chunkBytes, 1);
+
+        auto chunks = splitChunks(chunkBytes, delimiter);
+        auto publisher = ringBuffer.createBatchPublisher(batchSize);
+
+        // Bounded look-ahead: at most `threads` chunks parsed ahead of the publisher.
+        std::deque<std::future<std::vector<T>>> inFlight;
+        size_t nextChunk = 0;
+        auto launch = [&] {
+            const Chunk chunk = chunks[nextChunk++];
+            inFlight.push_back(std::async(std::launch::async, [this, chunk, &parser, delimiter] {
+                return parseChunk(chunk, parser, delimiter);
+            }));
+        };
+        while (nextChunk < chunks.size() && inFlight.size() < static_cast<size_t>(threads))
+        {
+            launch();
+        }
+
+        long published = 0;
+        for (size_t c = 0; c < chunks.size(); ++c)
+        {
+            std::vector<T> events = inFlight.front().get();
+            inFlight.pop_front();
+            if (nextChunk < chunks.size())
+            {
+                launch();
+            }
+
+            size_t offset = 0;
+            while (offset < events.size())
+            {
+                int n = static_cast<int>(std::min<size_t>(static_cast<size_t>(batchSize), events.size() - offset));
+                publisher.beginBatch(n);
+                for (int i = 0; i < n; ++i)
+                {
+                    publisher.getEvent(i) = events[offset + static_cast<size_t>(i)];
+                }
+                publisher.endBatch();
+                offset += static_cast<size_t>(n);
+            }
+            published += static_cast<long>(events.size());
+
+            if (releaseSequence_ != nullptr)
+            {
+                published_.push_back({chunks[c].end, ringBuffer.getCursor()});
+                releaseConsumed();
+            }
+        }
+        return published;
+    }
+
+    /**
+     * Release pages of chunks the release sequence has passed. publishAll calls
+     * this after every chunk; call it again once consumers have drained.
+     */
+    void releaseConsumed()
+    {
+        if (releaseSequence_ == nullptr)
+        {
+            return;
+        }
+        long consumed = releaseSequence_->get();
+        while (!published_.empty() && published_.front().lastSequence <= consumed)
+        {
+            size_t end = published_.front().end & ~(pageSize() - 1);
+            if (end > releasedUpTo_)
+            {
+                ::madvise(const_cast<char*>(data_) + releasedUpTo_, end - releasedUpTo_, MADV_DONTNEED);
+                releasedBytes_ += end - releasedUpTo_;
+                releasedUpTo_ = end;
+            }
+            published_.pop_front();
+        }
+    }
+
+    size_t getReleasedBytes() const { return releasedBytes_; }
+
+private:
+    struct Chunk
+    {
+        size_t begin;
+        size_t end;
+    };
+
+    struct PublishedChunk
+    {
+        size_t end;
+        long lastSequence;
+    };
+
+    static size_t pageSize()
+    {
+        static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    std::vector<Chunk> splitChunks(size_t chunkBytes, char delimiter) const
+    {
+        std::vector<Chunk> chunks;
+        size_t begin = 0;
+        while (begin < size_)
+        {
+            size_t end = std::min(size_, begin + chunkBytes);
+            if (end < size_)
+            {
+                const void* hit = std::memchr(data_ + end, delimiter, size_ - end);
+                end = hit == nullptr ? size_ : static_cast<size_t>(static_cast<const char*>(hit) - data_) + 1;
+            }
+            chunks.push_back({begin, end});
+            begin = end;
+        }
+        return chunks;
+    }
+
+    std::vector<T> parseChunk(Chunk chunk, const Parser& parser, char delimiter) const
+    {
+        size_t pageBegin = chunk.begin & ~(pageSize() - 1);
+        ::madvise(const_cast<char*>(data_) + pageBegin, chunk.end - pageBegin, MADV_WILLNEED);
+        std::vector<T> events;
+        size_t pos = chunk.begin;
+        while (pos < chunk.end)
+        {
+            const void* hit = std::memchr(data_ + pos, delimiter, chunk.end - pos);
+            size_t recordEnd = hit == nullptr ? chunk.end : static_cast<size_t>(static_cast<const char*>(hit) - data_);
+            T event{};
+            if (parser(data_ + pos, recordEnd - pos, event))
+            {
+                events.push_back(event);
+            }
+            pos = recordEnd + 1;
+        }
+        return events;
+    }
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    Sequence* releaseSequence_ = nullptr;
+    std::deque<PublishedChunk> published_;
+    size_t releasedUpTo_ = 0;
+    size_t releasedBytes_ = 0;
+};
+
+} // namespace disruptor
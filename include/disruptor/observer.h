@@ -0,0 +1,127 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "ring_buffer.h"
+
+namespace disruptor
+{
+
+/**
+ * Lossy, non-gating reader for monitoring, UI and sampling consumers.
+ *
+ * An observer is never added to the gating set, so it cannot slow producers;
+ * in exchange a producer may overwrite a slot while the observer copies it.
+ * Reads work like a seqlock: copy a batch of slots, then check the producers'
+ * claim position (RingBuffer::getClaimBound()). Any slot a producer may have
+ * started reusing is discarded, and an observer that has fallen a full ring
+ * behind jumps forward. Lost events are counted in getLappedCount().
+ *
+ *   RingObserver<Tick> observer(ringBuffer);
+ *   while (running) observer.poll([&](const Tick& tick, long seq) { ui.update(tick); });
+ *
+ * Events are delivered as copies, so T must be trivially copyable.
+ */
+template <typename T>
+class RingObserver
+{
+    static_assert(std::is_trivially_copyable_v<T>, "RingObserver copies slots that producers may be writing");
+
+public:
+    /**
+     * Starts at the next event to be published.
+     *
+     * @param maxBatch  slots copied and validated per poll()
+     */
+    explicit RingObserver(RingBuffer<T>& ringBuffer, int maxBatch = 256)
+        : ringBuffer_(ringBuffer),
+          maxBatch_(std::max(1, std::min(maxBatch, ringBuffer.getBufferSize()))),
+          scratch_(static_cast<size_t>(maxBatch_)),
+          next_(ringBuffer.getCursor() + 1)
+    {
+        ringBuffer_.enableClaimTracking();
+    }
+
+    /**
+     * Deliver up to maxBatch published events to fn(const T&, long sequence).
+     * Never blocks. Returns the number of events delivered.
+     */
+    template <typename Fn>
+    int poll(Fn&& fn)
+    {
+        skipOverwritten(ringBuffer_.getClaimBound());
+
+        long cursor = ringBuffer_.getCursor();
+        if (cursor < next_)
+        {
+            return 0;
+        }
+        long hi = ringBuffer_.getHighestPublishedSequence(next_, std::min(cursor, next_ + maxBatch_ - 1));
+        if (hi < next_)
+        {
+            return 0;
+        }
+
+        const long lo = next_;
+        for (long seq = lo; seq <= hi; ++seq)
+        {
+            std::memcpy(static_cast<void*>(&scratch_[static_cast<size_t>(seq - lo)]), &ringBuffer_.get(seq), sizeof(T));
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        // Copies of slots a producer has reclaimed since may be torn.
+        const long firstIntact = ringBuffer_.getClaimBound() - ringBuffer_.getBufferSize() + 1;
+        const long firstValid = std::max(lo, firstIntact);
+        int delivered = 0;
+        for (long seq = firstValid; seq <= hi; ++seq)
+        {
+            fn(static_cast<const T&>(scratch_[static_cast<size_t>(seq - lo)]), seq);
+            ++delivered;
+        }
+
+        next_ = std::max(hi + 1, firstIntact);
+        lapped_ += (next_ - lo) - delivered;
+        observed_ += delivered;
+        return delivered;
+    }
+
+    /**
+     * Skip everything published so far; the next poll starts at new events.
+     */
+    void skipToCursor()
+    {
+        next_ = std::max(next_, ringBuffer_.getCursor() + 1);
+    }
+
+    /** Next sequence this observer will read. */
+    long getNextSequence() const { return next_; }
+
+    long getObservedCount() const { return observed_; }
+
+    /** Events lost because a producer overwrote them before they were read. */
+    long getLappedCount() const { return lapped_; }
+
+private:
+    void skipOverwritten(long claimBound)
+    {
+        const long firstIntact = claimBound - ringBuffer_.getBufferSize() + 1;
+        if (next_ < firstIntact)
+        {
+            lapped_ += firstIntact - next_;
+            next_ = firstIntact;
+        }
+    }
+
+    RingBuffer<T>& ringBuffer_;
+    int maxBatch_;
+    std::vector<T> scratch_;
+    long next_;
+    long observed_ = 0;
+    long lapped_ = 0;
+};
+
+} // namespace disruptor
@@ -3,8 +3,10 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <climits>
 #include <cmath>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <thread>
 #include <vector>
@@ -51,6 +53,32 @@ public:
     virtual bool isAvailable(long sequence) = 0;
     virtual long getHighestPublishedSequence(long lowerBound, long availableSequence) = 0;
 
+    /**
+     * Move the cursor to a specific sequence so the next claim returns sequence + 1.
+     * Only for initialising a ring (e.g. recovery) before any producer runs.
+     */
+    virtual void claim(long sequence) = 0;
+
+    /**
+     * Highest sequence claimed by any producer (published or not). Slots at or
+     * below getClaimBound() - bufferSize may be mid-overwrite. Exact only once
+     * enableClaimTracking() has been called; before that it may be higher.
+     */
+    virtual long getClaimBound() = 0;
+
+    /**
+     * Make getClaimBound() exact, for readers that detect overwrites (RingObserver,
+     * slow-consumer eviction). Costs the single producer a store per claim, so it
+     * is off until one of them asks. Until the producer's next claim the bound
+     * stays conservative.
+     */
+    virtual void enableClaimTracking() = 0;
+
+    /**
+     * Slowest gating sequence, or the cursor when nothing gates the ring.
+     */
+    virtual long getMinimumGatingSequence() = 0;
+
     virtual void addGatingSequences(const std::vector<Sequence*>& sequences) = 0;
     virtual bool removeGatingSequence(Sequence* sequence) = 0;
 };
@@ -62,6 +90,8 @@ public:
         : bufferSize(bufferSize), waitStrategy(waitStrategy), cursor(Sequence::INITIAL_VALUE)
     {
         assert(isPowerOfTwo(bufferSize));
+        gatingArrays.push_back(std::make_unique<GatingArray>(INITIAL_GATING_CAPACITY));
+        gatingSequences.store(gatingArrays.back().get(), std::memory_order_release);
     }
 
     int getBufferSize() const override { return bufferSize; }
@@ -69,27 +99,124 @@ public:
     Sequence& getPublishedCursor() override { return cursor; }
     WaitStrategy& getWaitStrategy() override { return waitStrategy; }
 
+    long getMinimumGatingSequence() override
+    {
+        return gatingMinimum(cursor.get());
+    }
+
+    /**
+     * Safe while producers run. Sequences live in fixed slots that are
+     * filled and cleared in place, so a producer scanning concurrently sees
+     * each one either before or after the change, never a moved entry.
+     */
     void addGatingSequences(const std::vector<Sequence*>& sequences) override
     {
-        gatingSequences.insert(gatingSequences.end(), sequences.begin(), sequences.end());
+        std::lock_guard<std::mutex> lock(gatingMutex);
+        for (Sequence* sequence : sequences)
+        {
+            GatingArray* current = gatingSequences.load(std::memory_order_relaxed);
+            if (!current->tryAdd(sequence))
+            {
+                grow(*current).tryAdd(sequence);
+            }
+        }
     }
 
     bool removeGatingSequence(Sequence* sequence) override
     {
-        auto it = std::find(gatingSequences.begin(), gatingSequences.end(), sequence);
-        if (it == gatingSequences.end())
+        std::lock_guard<std::mutex> lock(gatingMutex);
+        GatingArray& current = *gatingSequences.load(std::memory_order_relaxed);
+        const size_t used = current.used.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < used; ++i)
         {
-            return false;
+            if (current.slots[i].load(std::memory_order_relaxed) == sequence)
+            {
+                current.slots[i].store(nullptr, std::memory_order_release);
+                return true;
+            }
         }
-        gatingSequences.erase(it);
-        return true;
+        return false;
     }
 
 protected:
+    /**
+     * Minimum of the gating sequences, or defaultValue if there are none.
+     */
+    long gatingMinimum(long defaultValue) const
+    {
+        const GatingArray& current = *gatingSequences.load(std::memory_order_acquire);
+        const size_t used = current.used.load(std::memory_order_acquire);
+        long minimum = LONG_MAX;
+        bool found = false;
+        for (size_t i = 0; i < used; ++i)
+        {
+            if (Sequence* sequence = current.slots[i].load(std::memory_order_acquire))
+            {
+                minimum = std::min(minimum, sequence->get());
+                found = true;
+            }
+        }
+        return found ? minimum : defaultValue;
+    }
+
     int bufferSize;
     WaitStrategy& waitStrategy;
     Sequence cursor;
-    std::vector<Sequence*> gatingSequences;
+
+private:
+    static constexpr size_t INITIAL_GATING_CAPACITY = 8;
+
+    struct GatingArray
+    {
+        explicit GatingArray(size_t capacity)
+            : capacity(capacity), slots(std::make_unique<std::atomic<Sequence*>[]>(capacity))
+        {
+        }
+
+        /** Reuse a cleared slot, else take a fresh one. False when full. */
+        bool tryAdd(Sequence* sequence)
+        {
+            const size_t n = used.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < n; ++i)
+            {
+                if (slots[i].load(std::memory_order_relaxed) == nullptr)
+                {
+                    slots[i].store(sequence, std::memory_order_release);
+                    return true;
+                }
+            }
+            if (n == capacity)
+            {
+                return false;
+            }
+            slots[n].store(sequence, std::memory_order_relaxed);
+            used.store(n + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_t capacity;
+        std::atomic<size_t> used{0};  // slots [0, used) may hold a sequence
+        std::unique_ptr<std::atomic<Sequence*>[]> slots;
+    };
+
+    GatingArray& grow(const GatingArray& full)
+    {
+        auto next = std::make_unique<GatingArray>(full.capacity * 2);
+        for (size_t i = 0; i < full.capacity; ++i)
+        {
+            next->tryAdd(full.slots[i].load(std::memory_order_relaxed));
+        }
+        gatingSequences.store(next.get(), std::memory_order_release);
+        // A producer may still be scanning the old array. Arrays are only
+        // replaced when full, so the retired ones never add up to more than
+        // the current one, however often consumers leave and rejoin.
+        gatingArrays.push_back(std::move(next));
+        return *gatingArrays.back();
+    }
+
+    std::mutex gatingMutex;
+    std::vector<std::unique_ptr<GatingArray>> gatingArrays;
+    std::atomic<GatingArray*> gatingSequences{nullptr};
 };
 
 /**
@@ -113,7 +240,7 @@ public:
 
     long remainingCapacity() override
     {
-        long consumed = getMinimumSequence(gatingSequences, nextValue);
+        long consumed = gatingMinimum(nextValue);
         long produced = nextValue;
         return bufferSize - (produced - consumed);
     }
@@ -130,7 +257,7 @@ public:
         {
             cursor.set(nextValue);  // release is sufficient
             long minSequence;
-            while (wrapPoint > (minSequence = getMinimumSequence(gatingSequences, nextValue)))
+            while (wrapPoint > (minSequence = gatingMinimum(nextValue)))
             {
                 // Use pause instruction for efficient spinning
                 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
@@ -145,6 +272,7 @@ public:
         }
 
         nextValue = nextSeq;
+        markClaimed(nextSeq);
         return nextSeq;
     }
 
@@ -163,7 +291,7 @@ public:
         {
             cursor.set(nextValue);
             long minSequence;
-            while (wrapPoint > (minSequence = getMinimumSequence(gatingSequences, nextValue)))
+            while (wrapPoint > (minSequence = gatingMinimum(nextValue)))
             {
                 #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
                     __builtin_ia32_pause();
@@ -177,6 +305,7 @@ public:
         }
 
         nextValue = nextSeq;
+        markClaimed(nextSeq);
         return nextSeq;
     }
 
@@ -195,6 +324,7 @@ public:
         }
 
         nextValue += n;
+        markClaimed(nextValue);
         return nextValue;
     }
 
@@ -220,7 +350,55 @@ public:
         return availableSequence;
     }
 
+    long getClaimBound() override
+    {
+        long bound = claimed.get();
+        if (bound == UNTRACKED)
+        {
+            // Every claim is at most a buffer ahead of the consumers, which
+            // are at or behind the cursor.
+            return cursor.get() + bufferSize;
+        }
+        return bound;
+    }
+
+    void enableClaimTracking() override
+    {
+        if (!trackClaims.load(std::memory_order_acquire))
+        {
+            claimed.set(UNTRACKED);
+            trackClaims.store(true, std::memory_order_release);
+        }
+    }
+
+    void claim(long sequence) override
+    {
+        nextValue = sequence;
+        cachedValue = Sequence::INITIAL_VALUE;
+        if (trackClaims.load(std::memory_order_acquire))
+        {
+            claimed.set(sequence);
+        }
+        cursor.set(sequence);
+    }
+
 private:
+    static constexpr long UNTRACKED = LONG_MIN;
+
+    /**
+     * Make the claim visible before the producer writes the slot, so a
+     * non-gating reader that sees a partial write also sees the claim.
+     * A plain store plus compiler barrier on x86, and only while tracking.
+     */
+    void markClaimed(long sequence)
+    {
+        if (__builtin_expect(trackClaims.load(std::memory_order_acquire), 0))
+        {
+            claimed.setRelaxed(sequence);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+    }
+
     bool hasAvailableCapacity(int requiredCapacity, bool doStore)
     {
         long wrapPoint = (nextValue + requiredCapacity) - bufferSize;
@@ -233,7 +411,7 @@ private:
                 cursor.set(nextValue);
             }
 
-            long minSequence = getMinimumSequence(gatingSequences, nextValue);
+            long minSequence = gatingMinimum(nextValue);
             cachedValue = minSequence;
             if (wrapPoint > minSequence)
             {
@@ -246,6 +424,8 @@ private:
 
     long nextValue = Sequence::INITIAL_VALUE;
     long cachedValue = Sequence::INITIAL_VALUE;
+    std::atomic<bool> trackClaims{false};
+    Sequence claimed{UNTRACKED};  // UNTRACKED until tracking sees a claim
 };
 
 /**
@@ -273,7 +453,7 @@ public:
 
     long remainingCapacity() override
     {
-        long consumed = getMinimumSequence(gatingSequences, cursor.get());
+        long consumed = gatingMinimum(cursor.get());
         long produced = cursor.get();
         return bufferSize - (produced - consumed);
     }
@@ -285,6 +465,7 @@ public:
         thread_local long localGatingCache = Sequence::INITIAL_VALUE;
         
         long current = cursor.getAndAdd(1);
+        std::atomic_thread_fence(std::memory_order_release);  // claim visible before slot writes
         long nextSequence = current + 1;
         long wrapPoint = nextSequence - bufferSize;
         
@@ -296,7 +477,7 @@ public:
             if (wrapPoint > cachedGating || cachedGating > current)
             {
                 long gatingSequence;
-                while (wrapPoint > (gatingSequence = getMinimumSequence(gatingSequences, current)))
+                while (wrapPoint > (gatingSequence = gatingMinimum(current)))
                 {
                     #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
                         __builtin_ia32_pause();
@@ -329,6 +510,7 @@ public:
         thread_local long localGatingCache = Sequence::INITIAL_VALUE;
         
         long current = cursor.getAndAdd(n);
+        std::atomic_thread_fence(std::memory_order_release);  // claim visible before slot writes
         long nextSequence = current + n;
         long wrapPoint = nextSequence - bufferSize;
         
@@ -339,7 +521,7 @@ public:
             if (wrapPoint > cachedGating || cachedGating > current)
             {
                 long gatingSequence;
-                while (wrapPoint > (gatingSequence = getMinimumSequence(gatingSequences, current)))
+                while (wrapPoint > (gatingSequence = gatingMinimum(current)))
                 {
                     #if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
                         __builtin_ia32_pause();
@@ -382,6 +564,7 @@ public:
             }
         }
         while (!cursor.compareAndSet(current, nextSequence));
+        std::atomic_thread_fence(std::memory_order_release);
 
         return nextSequence;
     }
@@ -397,11 +580,9 @@ public:
 
     void publish(long lo, long hi) override
     {
-        // Batch write without fence, then single fence at end (Java-style optimization)
-        for (long s = lo; s <= hi; ++s)
-        {
-            setAvailableBufferValue(calculateIndex(s), calculateAvailabilityFlag(s));
-        }
+        // Slot writes before flags; one fence for the whole range
+        std::atomic_thread_fence(std::memory_order_release);
+        setAvailableRange(lo, hi);
         std::atomic_thread_fence(std::memory_order_release);
         waitStrategy.signalAllWhenBlocking();
     }
@@ -426,6 +607,20 @@ public:
         return availableSequence;
     }
 
+    long getClaimBound() override
+    {
+        // The cursor is the claim counter here.
+        return cursor.get();
+    }
+
+    void enableClaimTracking() override {}
+
+    void claim(long sequence) override
+    {
+        gatingSequenceCache.set(Sequence::INITIAL_VALUE);
+        cursor.set(sequence);
+    }
+
 private:
     bool hasAvailableCapacity(int requiredCapacity, long cursorValue)
     {
@@ -434,7 +629,7 @@ private:
 
         if (wrapPoint > cachedGating || cachedGating > cursorValue)
         {
-            long minSequence = getMinimumSequence(gatingSequences, cursorValue);
+            long minSequence = gatingMinimum(cursorValue);
             gatingSequenceCache.set(minSequence);
             if (wrapPoint > minSequence)
             {
@@ -451,6 +646,21 @@ private:
         availableBuffer[index] = flag;
     }
 
+    // A range of at most bufferSize sequences covers at most two runs of
+    // slots (before and after the wrap), each sharing one flag, so it is two
+    // fills instead of a shift and mask per sequence.
+    void setAvailableRange(long lo, long hi)
+    {
+        while (lo <= hi)
+        {
+            const int index = calculateIndex(lo);
+            const long runEnd = std::min(hi, lo + (indexMask - index));
+            std::fill(availableBuffer.begin() + index, availableBuffer.begin() + index + (runEnd - lo + 1),
+                      calculateAvailabilityFlag(lo));
+            lo = runEnd + 1;
+        }
+    }
+
     int calculateAvailabilityFlag(long sequence) const
     {
         return static_cast<int>(sequence >> indexShift);
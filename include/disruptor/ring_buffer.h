@@ -78,6 +78,36 @@ public:
 
     long getCursor() const { return sequencer->getCursor().get(); }
 
+    /**
+     * Highest contiguously published sequence in [lowerBound, availableSequence].
+     */
+    long getHighestPublishedSequence(long lowerBound, long availableSequence)
+    {
+        return sequencer->getHighestPublishedSequence(lowerBound, availableSequence);
+    }
+
+    /**
+     * See Sequencer::getClaimBound(); used by non-gating readers to detect overwrites.
+     */
+    long getClaimBound() { return sequencer->getClaimBound(); }
+
+    /**
+     * See Sequencer::enableClaimTracking().
+     */
+    void enableClaimTracking() { sequencer->enableClaimTracking(); }
+
+    /**
+     * Slowest consumer's sequence (the cursor when nothing gates the ring).
+     */
+    long getMinimumGatingSequence() { return sequencer->getMinimumGatingSequence(); }
+
+    /**
+     * Position the ring so the next claimed sequence is sequence + 1 (e.g. to resume
+     * numbering after recovery). Call before producers start; consumers resume by
+     * setting their own Sequence to the same value before run().
+     */
+    void resetTo(long sequence) { sequencer->claim(sequence); }
+
     SequenceBarrier newBarrier(const std::vector<Sequence*>& dependents = {})
     {
         return SequenceBarrier(sequencer->getWaitStrategy(), sequencer->getCursor(), dependents,
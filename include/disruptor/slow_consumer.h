@@ -0,0 +1,181 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "batch_event_processor.h"
+#include "ring_buffer.h"
+
+namespace disruptor
+{
+
+/**
+ * When a gating consumer counts as too slow. Either limit may be 0 (off).
+ */
+struct SlowConsumerPolicy
+{
+    /**
+     * Evict when cursor - consumer sequence exceeds this many slots. Must be
+     * below the buffer size to fire before producers block; note a producer
+     * running flat out can briefly put healthy consumers this far behind too.
+     */
+    long maxLagSlots = 0;
+
+    /** Evict when the consumer is behind and has made no progress for this long. */
+    std::chrono::nanoseconds maxStall{0};
+
+    /** How often the background thread checks, when started. */
+    std::chrono::nanoseconds checkInterval = std::chrono::milliseconds(1);
+};
+
+/**
+ * Supervisor for broadcast topologies: detaches a lagging or stalled consumer
+ * from the gating set so one slow reader cannot hold up every producer once
+ * the ring wraps. The evicted processor learns it was lapped
+ * (EventHandler::onLapped) and rejoins at the cursor on its own, after which
+ * it is watched again.
+ *
+ *   SlowConsumerMonitor<Event> monitor(ringBuffer, {.maxLagSlots = 3 * size / 4});
+ *   monitor.watch(processorA);
+ *   monitor.watch(processorB);
+ *   monitor.start();
+ *
+ * Call checkOnce() directly to drive it from an existing housekeeping loop.
+ */
+template <typename T>
+class SlowConsumerMonitor
+{
+public:
+    using EvictionListener = std::function<void(BatchEventProcessor<T>& processor, long lag)>;
+
+    SlowConsumerMonitor(RingBuffer<T>& ringBuffer, SlowConsumerPolicy policy, EvictionListener onEvicted = {})
+        : ringBuffer_(ringBuffer), policy_(policy), onEvicted_(std::move(onEvicted))
+    {
+    }
+
+    ~SlowConsumerMonitor()
+    {
+        stop();
+    }
+
+    SlowConsumerMonitor(const SlowConsumerMonitor&) = delete;
+    SlowConsumerMonitor& operator=(const SlowConsumerMonitor&) = delete;
+
+    /**
+     * Watch a processor that is a gating sequence of the ring.
+     */
+    void watch(BatchEventProcessor<T>& processor)
+    {
+        // Rejoining after an eviction needs the exact claim position.
+        ringBuffer_.enableClaimTracking();
+        std::lock_guard<std::mutex> lock(mutex_);
+        watched_.push_back({&processor, processor.getSequence().get(), std::chrono::steady_clock::now()});
+    }
+
+    /**
+     * Evaluate every watched processor once. Returns the number evicted.
+     */
+    int checkOnce()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto now = std::chrono::steady_clock::now();
+        const long cursor = ringBuffer_.getCursor();
+        int evicted = 0;
+
+        for (auto& consumer : watched_)
+        {
+            const long sequence = consumer.processor->getSequence().get();
+            const long lag = cursor - sequence;
+            if (sequence != consumer.lastSequence || lag <= 0)
+            {
+                consumer.lastSequence = sequence;
+                consumer.lastProgress = now;
+            }
+            if (consumer.processor->isEvicted())
+            {
+                continue;
+            }
+
+            const bool lagging = policy_.maxLagSlots > 0 && lag > policy_.maxLagSlots;
+            const bool stalled = policy_.maxStall.count() > 0 && lag > 0 && now - consumer.lastProgress > policy_.maxStall;
+            if ((lagging || stalled) && consumer.processor->evict())
+            {
+                ++evicted;
+                evictions_.fetch_add(1, std::memory_order_relaxed);
+                consumer.lastProgress = now;
+                if (onEvicted_)
+                {
+                    onEvicted_(*consumer.processor, lag);
+                }
+            }
+        }
+        return evicted;
+    }
+
+    /**
+     * Check every policy.checkInterval on a background thread until stop().
+     */
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        if (thread_.joinable())
+        {
+            return;
+        }
+        stopping_ = false;
+        thread_ = std::thread([this] {
+            std::unique_lock<std::mutex> lock(threadMutex_);
+            while (!stopping_)
+            {
+                lock.unlock();
+                checkOnce();
+                lock.lock();
+                wake_.wait_for(lock, policy_.checkInterval, [this] { return stopping_; });
+            }
+        });
+    }
+
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(threadMutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    }
+
+    long getEvictionCount() const { return evictions_.load(std::memory_order_relaxed); }
+
+private:
+    struct Watched
+    {
+        BatchEventProcessor<T>* processor;
+        long lastSequence;
+        std::chrono::steady_clock::time_point lastProgress;
+    };
+
+    RingBuffer<T>& ringBuffer_;
+    SlowConsumerPolicy policy_;
+    EvictionListener onEvicted_;
+
+    std::mutex mutex_;
+    std::vector<Watched> watched_;
+    std::atomic<long> evictions_{0};
+
+    std::mutex threadMutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+} // namespace disruptor
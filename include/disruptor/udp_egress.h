@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "event_handler.h"
+#include "udp_ingest.h"
+
+namespace disruptor
+{
+
+/**
+ * UDP egress stage: collects outbound datagrams during a batch and sends them
+ * with one sendmmsg() at endOfBatch (or when maxBatch messages are queued).
+ *
+ * The iovecs point into the ring slots themselves. The processor only advances
+ * its sequence after onEvent returns, and sendmmsg has copied the payloads into
+ * the kernel by then, so producers cannot reuse a slot before it is sent.
+ * Zero-length events are skipped.
+ */
+template <typename T, typename Traits = DatagramTraits<T>>
+class UdpEgressHandler final : public EventHandler<T>
+{
+public:
+    /**
+     * @param fd           UDP socket; connected, or pass destination
+     * @param destination  optional target address (nullptr for a connected socket)
+     */
+    explicit UdpEgressHandler(int fd, const sockaddr* destination = nullptr, socklen_t destinationLength = 0,
+                              int maxBatch = 64)
+        : fd_(fd),
+          maxBatch_(std::max(1, std::min(maxBatch, 1024))),
+          iovecs_(static_cast<size_t>(maxBatch_)),
+          headers_(static_cast<size_t>(maxBatch_))
+    {
+        if (destination != nullptr)
+        {
+            if (destinationLength > sizeof(destination_))
+            {
+                throw std::invalid_argument("destination address too long");
+            }
+            std::memcpy(&destination_, destination, destinationLength);
+            destinationLength_ = destinationLength;
+        }
+    }
+
+    void onEvent(T& event, long, bool endOfBatch) override
+    {
+        size_t length = Traits::length(event);
+        if (length > 0)
+        {
+            iovecs_[static_cast<size_t>(queued_)] = {Traits::data(event), length};
+            ++queued_;
+        }
+        if (endOfBatch || queued_ == maxBatch_)
+        {
+            flush();
+        }
+    }
+
+    /**
+     * Send everything queued. Called automatically at endOfBatch.
+     */
+    void flush()
+    {
+        int offset = 0;
+        while (offset < queued_)
+        {
+            int count = queued_ - offset;
+            for (int i = 0; i < count; ++i)
+            {
+                mmsghdr& header = headers_[static_cast<size_t>(i)];
+                std::memset(&header, 0, sizeof(header));
+                header.msg_hdr.msg_iov = &iovecs_[static_cast<size_t>(offset + i)];
+                header.msg_hdr.msg_iovlen = 1;
+                if (destinationLength_ > 0)
+                {
+                    header.msg_hdr.msg_name = &destination_;
+                    header.msg_hdr.msg_namelen = destinationLength_;
+                }
+            }
+            int sent = ::sendmmsg(fd_, headers_.data(), static_cast<unsigned>(count), 0);
+            if (sent < 0)
+            {
+                if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    continue;
+                }
+                queued_ = 0;
+                throw std::runtime_error(std::string("sendmmsg failed: ") + std::strerror(errno));
+            }
+            offset += sent;
+            ++sendCalls_;
+        }
+        sent_ += queued_;
+        queued_ = 0;
+    }
+
+    long getSentCount() const { return sent_; }
+
+    /**
+     * sendmmsg calls made; sent / calls is the mean datagrams per syscall.
+     */
+    long getSendCalls() const { return sendCalls_; }
+
+private:
+    int fd_;
+    int maxBatch_;
+    std::vector<iovec> iovecs_;
+    std::vector<mmsghdr> headers_;
+    sockaddr_storage destination_{};
+    socklen_t destinationLength_ = 0;
+
+    int queued_ = 0;
+    long sent_ = 0;
+    long sendCalls_ = 0;
+};
+
+} // namespace disruptor
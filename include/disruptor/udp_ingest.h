@@ -0,0 +1,184 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "ring_buffer.h"
+
+namespace disruptor
+{
+
+/**
+ * Fixed-capacity datagram event: the payload is received into (and sent from)
+ * the ring slot itself.
+ */
+template <size_t Capacity>
+struct Datagram
+{
+    uint32_t length = 0;
+    bool truncated = false;
+    char data[Capacity];
+};
+
+/**
+ * How the UDP components find the payload buffer inside an event.
+ * Specialise for event types that do not follow Datagram's layout.
+ */
+template <typename T>
+struct DatagramTraits
+{
+    static char* data(T& event) { return event.data; }
+    static size_t capacity(const T& event) { return sizeof(event.data); }
+    static size_t length(const T& event) { return event.length; }
+    static void setLength(T& event, size_t length, bool truncated)
+    {
+        event.length = static_cast<uint32_t>(length);
+        event.truncated = truncated;
+    }
+};
+
+/**
+ * UDP ingest producer: claims a batch of slots with next(n) and receives
+ * datagrams directly into them with one recvmmsg(), then publishes only the
+ * slots that were filled. Slots claimed but not filled stay claimed and are
+ * filled first on the next call, so published sequences never have gaps.
+ *
+ * Meant to be the ring's producer thread (single producer). On a
+ * multi-producer ring, held slots delay other producers' events, so call
+ * releasePending() before idling.
+ */
+template <typename T, typename Traits = DatagramTraits<T>>
+class UdpIngest
+{
+public:
+    /**
+     * @param fd         bound UDP socket; give it SO_RCVTIMEO so run() can notice shutdown
+     * @param batchSize  slots claimed (and datagrams received) per recvmmsg
+     */
+    UdpIngest(RingBuffer<T>& ringBuffer, int fd, int batchSize = 64)
+        : ringBuffer_(ringBuffer),
+          fd_(fd),
+          batchSize_(std::max(1, std::min(batchSize, ringBuffer.getBufferSize()))),
+          iovecs_(static_cast<size_t>(batchSize_)),
+          headers_(static_cast<size_t>(batchSize_))
+    {
+    }
+
+    ~UdpIngest()
+    {
+        releasePending();
+    }
+
+    UdpIngest(const UdpIngest&) = delete;
+    UdpIngest& operator=(const UdpIngest&) = delete;
+
+    /**
+     * One recvmmsg() into the claimed slots. Blocks until at least one datagram
+     * arrives (or the socket times out). Returns the number of events published.
+     */
+    int pollOnce()
+    {
+        if (pendingLo_ > pendingHi_)
+        {
+            pendingHi_ = ringBuffer_.next(batchSize_);
+            pendingLo_ = pendingHi_ - batchSize_ + 1;
+        }
+
+        const int count = static_cast<int>(pendingHi_ - pendingLo_ + 1);
+        for (int i = 0; i < count; ++i)
+        {
+            T& slot = ringBuffer_.get(pendingLo_ + i);
+            iovecs_[static_cast<size_t>(i)] = {Traits::data(slot), Traits::capacity(slot)};
+            std::memset(&headers_[static_cast<size_t>(i)], 0, sizeof(mmsghdr));
+            headers_[static_cast<size_t>(i)].msg_hdr.msg_iov = &iovecs_[static_cast<size_t>(i)];
+            headers_[static_cast<size_t>(i)].msg_hdr.msg_iovlen = 1;
+        }
+
+        int received = ::recvmmsg(fd_, headers_.data(), static_cast<unsigned>(count), MSG_WAITFORONE, nullptr);
+        if (received < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            {
+                return 0;
+            }
+            throw std::runtime_error(std::string("recvmmsg failed: ") + std::strerror(errno));
+        }
+
+        for (int i = 0; i < received; ++i)
+        {
+            const mmsghdr& header = headers_[static_cast<size_t>(i)];
+            bool truncated = (header.msg_hdr.msg_flags & MSG_TRUNC) != 0;
+            truncated_ += truncated ? 1 : 0;
+            Traits::setLength(ringBuffer_.get(pendingLo_ + i), header.msg_len, truncated);
+        }
+        if (received > 0)
+        {
+            ringBuffer_.publish(pendingLo_, pendingLo_ + received - 1);
+            pendingLo_ += received;
+            ++syscalls_;
+            published_ += received;
+        }
+        return received;
+    }
+
+    /**
+     * Receive until running becomes false, then release held slots.
+     */
+    void run(const std::atomic<bool>& running)
+    {
+        while (running.load(std::memory_order_acquire))
+        {
+            pollOnce();
+        }
+        releasePending();
+    }
+
+    /**
+     * Publish any claimed-but-unfilled slots as zero-length datagrams.
+     */
+    void releasePending()
+    {
+        if (pendingLo_ <= pendingHi_)
+        {
+            for (long seq = pendingLo_; seq <= pendingHi_; ++seq)
+            {
+                Traits::setLength(ringBuffer_.get(seq), 0, false);
+            }
+            ringBuffer_.publish(pendingLo_, pendingHi_);
+            pendingLo_ = pendingHi_ + 1;
+        }
+    }
+
+    long getPublishedCount() const { return published_; }
+    long getTruncatedCount() const { return truncated_; }
+
+    /**
+     * recvmmsg calls that returned data; published / syscalls is the mean batch.
+     */
+    long getReceiveCalls() const { return syscalls_; }
+
+private:
+    RingBuffer<T>& ringBuffer_;
+    int fd_;
+    int batchSize_;
+    std::vector<iovec> iovecs_;
+    std::vector<mmsghdr> headers_;
+
+    long pendingLo_ = 0;
+    long pendingHi_ = -1;
+    long published_ = 0;
+    long truncated_ = 0;
+    long syscalls_ = 0;
+};
+
+} // namespace disruptor
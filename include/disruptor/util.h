@@ -1,7 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <climits>
+#include <cstdint>
 #include <vector>
 
 #include "sequence.h"
@@ -22,4 +24,14 @@ inline long getMinimumSequence(const std::vector<Sequence*>& sequences, long def
     }
     return minimum;
 }
+
+/**
+ * Monotonic timestamp for stamping events at publish time (see
+ * BatchEventProcessor::setTimeToLive).
+ */
+inline int64_t steadyClockNanos()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
 } // namespace disruptor
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <climits>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
@@ -28,6 +31,37 @@ public:
     virtual long waitFor(long sequence, Sequence& cursor, const std::vector<Sequence*>& dependents,
         std::atomic<bool>& alerted) = 0;
     virtual void signalAllWhenBlocking() = 0;
+
+    /**
+     * Wake every blocked waiter so it sees an alert. Unlike
+     * signalAllWhenBlocking() this never skips a wakeup.
+     */
+    virtual void signalAlert() { signalAllWhenBlocking(); }
+
+    /**
+     * Wait until sequence + minEvents - 1 is available, or until the deadline
+     * once at least sequence is. Never returns less than sequence, so a
+     * consumer wakes once per minEvents events rather than once per publish.
+     *
+     * Default: waitFor the first event, then yield until the watermark or the
+     * deadline. Strategies that sleep override this.
+     */
+    virtual long waitForWatermark(long sequence, long minEvents, std::chrono::steady_clock::time_point deadline,
+        Sequence& cursor, const std::vector<Sequence*>& dependents, std::atomic<bool>& alerted)
+    {
+        const long target = sequence + minEvents - 1;
+        long available = waitFor(sequence, cursor, dependents, alerted);
+        while (available < target && std::chrono::steady_clock::now() < deadline)
+        {
+            if (alerted.load(std::memory_order_relaxed))
+            {
+                throw AlertException();
+            }
+            std::this_thread::yield();
+            available = getMinimumSequence(dependents, cursor.get());
+        }
+        return available;
+    }
 };
 
 /**
@@ -166,11 +200,45 @@ public:
     }
 
     void signalAllWhenBlocking() override {}
+
+    /**
+     * Below the watermark, nap in WATERMARK_NAP steps (bounded by the deadline)
+     * instead of backing off per event.
+     */
+    long waitForWatermark(long sequence, long minEvents, std::chrono::steady_clock::time_point deadline,
+        Sequence& cursor, const std::vector<Sequence*>& dependents, std::atomic<bool>& alerted) override
+    {
+        const long target = sequence + minEvents - 1;
+        while (true)
+        {
+            if (alerted.load(std::memory_order_relaxed))
+            {
+                throw AlertException();
+            }
+
+            long available = getMinimumSequence(dependents, cursor.get());
+            auto now = std::chrono::steady_clock::now();
+            if (available >= target || (available >= sequence && now >= deadline))
+            {
+                return available;
+            }
+            std::this_thread::sleep_for(now < deadline ? std::min<std::chrono::nanoseconds>(deadline - now, WATERMARK_NAP)
+                                                       : std::chrono::nanoseconds(WATERMARK_NAP));
+        }
+    }
+
+private:
+    static constexpr std::chrono::microseconds WATERMARK_NAP{100};
 };
 
 /**
  * Blocking wait strategy using condition variable.
  * Best for low-latency, low-throughput scenarios.
+ *
+ * Watermark waiters are only notified once the cursor reaches the lowest
+ * registered watermark, so publishes below it cost no wakeup. A strategy
+ * serving watermark waiters should belong to one ring, since that ring's
+ * cursor is what signalAllWhenBlocking() compares against.
  */
 class BlockingWaitStrategy final : public WaitStrategy
 {
@@ -179,6 +247,16 @@ public:
         std::atomic<bool>& alerted) override
     {
         std::unique_lock<std::mutex> lock(mutex);
+        ++eagerWaiters;
+        struct Leave
+        {
+            BlockingWaitStrategy& self;
+            ~Leave() { --self.eagerWaiters; }
+        } leave{*this};
+        // Pairs with the fence in signalAllWhenBlocking(): either the publisher
+        // sees us registered, or we see its cursor below.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
         while (true)
         {
             if (alerted.load(std::memory_order_acquire))
@@ -198,11 +276,86 @@ public:
 
     void signalAllWhenBlocking() override
     {
+        // Orders the caller's cursor store before the waiter checks (StoreLoad).
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // Only watermark waiters are asleep and none has reached its target.
+        const Sequence* cursor = watermarkCursor.load(std::memory_order_acquire);
+        if (eagerWaiters.load(std::memory_order_relaxed) == 0 && cursor != nullptr &&
+            cursor->get() < lowestWatermark.load(std::memory_order_relaxed))
+        {
+            return;
+        }
         cond.notify_all();
     }
 
+    void signalAlert() override
+    {
+        // Taking the mutex orders this after any waiter's alert check, so the
+        // waiter is either about to see the flag or already asleep.
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+        }
+        cond.notify_all();
+    }
+
+    long waitForWatermark(long sequence, long minEvents, std::chrono::steady_clock::time_point deadline,
+        Sequence& cursor, const std::vector<Sequence*>& dependents, std::atomic<bool>& alerted) override
+    {
+        const long target = sequence + minEvents - 1;
+        std::unique_lock<std::mutex> lock(mutex);
+        watermarkCursor.store(&cursor, std::memory_order_release);
+        watermarks.push_back(target);
+        updateLowestWatermark();
+        struct Leave
+        {
+            BlockingWaitStrategy& self;
+            long target;
+            ~Leave()
+            {
+                self.watermarks.erase(std::find(self.watermarks.begin(), self.watermarks.end(), target));
+                self.updateLowestWatermark();
+                if (self.watermarks.empty())
+                {
+                    self.watermarkCursor.store(nullptr, std::memory_order_release);
+                }
+            }
+        } leave{*this, target};
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        while (true)
+        {
+            if (alerted.load(std::memory_order_acquire))
+            {
+                throw AlertException();
+            }
+
+            long available = getMinimumSequence(dependents, cursor.get());
+            auto now = std::chrono::steady_clock::now();
+            if (available >= target || (available >= sequence && now >= deadline))
+            {
+                return available;
+            }
+            // Bounded sleep: covers a notify that raced our check and dependents,
+            // which never signal.
+            auto wake = now + WATERMARK_POLL;
+            cond.wait_until(lock, now < deadline ? std::min(deadline, wake) : wake);
+        }
+    }
+
 private:
+    static constexpr std::chrono::milliseconds WATERMARK_POLL{1};
+
+    void updateLowestWatermark()
+    {
+        lowestWatermark.store(watermarks.empty() ? LONG_MIN : *std::min_element(watermarks.begin(), watermarks.end()),
+                              std::memory_order_relaxed);
+    }
+
     std::mutex mutex;
     std::condition_variable cond;
+    std::atomic<int> eagerWaiters{0};
+    std::vector<long> watermarks;  // guarded by mutex
+    std::atomic<long> lowestWatermark{LONG_MIN};
+    std::atomic<const Sequence*> watermarkCursor{nullptr};
 };
 } // namespace disruptor
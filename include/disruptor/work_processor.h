@@ -8,6 +8,7 @@
 
 #include "consumer_barrier.h"
 #include "event_processor.h"
+#include "exception_handler.h"
 #include "exceptions.h"
 #include "ring_buffer.h"
 #include "sequence.h"
@@ -36,6 +37,15 @@ public:
     {
     }
 
+    /**
+     * Route handler exceptions to an ExceptionHandler instead of swallowing them.
+     * If it rethrows, the worker stops like a BatchEventProcessor would.
+     */
+    void setExceptionHandler(ExceptionHandler<T>& handler)
+    {
+        exceptionHandler_ = &handler;
+    }
+
     void run() override
     {
         running_.store(true, std::memory_order_release);
@@ -64,6 +74,12 @@ public:
                         nextSequence = base + 1;
                         claimedHi = base + workBatchSize_;
 
+                        // Gate at the claim point, as the Java WorkProcessor does.
+                        // A worker still showing the end of its previous chunk (or
+                        // the initial -1) would keep the producer from reaching the
+                        // chunk it just claimed, and it would wait on it forever.
+                        sequence_.set(base);
+
                         if (nextSequence > endSequenceInclusive_)
                         {
                             sequence_.set(endSequenceInclusive_);
@@ -90,14 +106,18 @@ public:
                     // Consume the whole currently-available window in one waitFor().
                     for (; nextSequence <= hi; ++nextSequence)
                     {
+                        T& evt = ringBuffer_.get(nextSequence);
                         try
                         {
-                            T& evt = ringBuffer_.get(nextSequence);
                             handler_.onEvent(evt, nextSequence);
                         }
                         catch (...)
                         {
-                            // Swallow handler exceptions to avoid stalling the worker pool.
+                            // Without a handler, swallow to avoid stalling the worker pool.
+                            if (exceptionHandler_ != nullptr)
+                            {
+                                exceptionHandler_->handleEventException(std::current_exception(), nextSequence, &evt);
+                            }
                         }
                     }
 
@@ -112,15 +132,16 @@ public:
                     }
                 }
             }
-
-            handler_.onShutdown();
         }
         catch (...)
         {
+            // A rethrowing exception handler stops the worker; the handler is still shut down.
+            notifyShutdown();
             running_.store(false, std::memory_order_release);
             throw;
         }
 
+        notifyShutdown();
         running_.store(false, std::memory_order_release);
     }
 
@@ -141,9 +162,26 @@ public:
     }
 
 private:
+    void notifyShutdown()
+    {
+        try
+        {
+            handler_.onShutdown();
+        }
+        catch (...)
+        {
+            if (exceptionHandler_ == nullptr)
+            {
+                throw;
+            }
+            exceptionHandler_->handleOnShutdownException(std::current_exception());
+        }
+    }
+
     RingBuffer<T>& ringBuffer_;
     SequenceBarrier barrier_;
     WorkHandler<T>& handler_;
+    ExceptionHandler<T>* exceptionHandler_ = nullptr;
     Sequence& workSequence_;
     long endSequenceInclusive_ = LONG_MAX;
     int workBatchSize_ = 1;
@@ -43,6 +43,17 @@ public:
         return seqs;
     }
 
+    /**
+     * Install an exception handler on every worker; it must be thread-safe.
+     */
+    void setExceptionHandler(ExceptionHandler<T>& handler)
+    {
+        for (auto& p : processors_)
+        {
+            p->setExceptionHandler(handler);
+        }
+    }
+
     void start()
     {
         threads_.clear();
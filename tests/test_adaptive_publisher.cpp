@@ -0,0 +1,177 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/adaptive_publisher.h"
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+struct TickEvent
+{
+    long value{0};
+};
+
+// AdaptiveBatchPublisherTest - 测试自适应批量发布：空闲立即发布、繁忙时增大批次、超时刷新
+
+namespace
+{
+void publishValue(disruptor::AdaptiveBatchPublisher<TickEvent>& publisher, long value)
+{
+    publisher.claim().value = value;
+    publisher.commit();
+}
+
+disruptor::AdaptiveBatchPolicy neverDue()
+{
+    disruptor::AdaptiveBatchPolicy policy;
+    policy.maxBatch = 64;
+    policy.maxDelay = std::chrono::hours(1);
+    return policy;
+}
+}
+
+TEST_CASE("AdaptiveBatchPublisher publishes immediately while the consumer keeps up", "[adaptive_publisher]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<TickEvent>::createSingleProducer([] { return TickEvent{}; }, 256, waitStrategy);
+    disruptor::Sequence consumer{disruptor::Sequence::INITIAL_VALUE};
+    ringBuffer.addGatingSequences({&consumer});
+
+    disruptor::AdaptiveBatchPublisher<TickEvent> publisher(ringBuffer, neverDue());
+    for (long i = 0; i < 100; ++i)
+    {
+        publishValue(publisher, i);
+        REQUIRE(ringBuffer.getCursor() == i);
+        REQUIRE(ringBuffer.get(i).value == i);
+        consumer.set(i);  // 消费者立即处理完
+    }
+
+    REQUIRE(publisher.getPublishedBatchCount() == 100);
+    REQUIRE(publisher.getTargetBatchSize() == 1);
+    REQUIRE(publisher.getPendingCount() == 0);
+}
+
+TEST_CASE("AdaptiveBatchPublisher grows its batch while the consumer is behind", "[adaptive_publisher]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<TickEvent>::createSingleProducer([] { return TickEvent{}; }, 1024, waitStrategy);
+    disruptor::Sequence consumer{disruptor::Sequence::INITIAL_VALUE};
+    ringBuffer.addGatingSequences({&consumer});
+
+    disruptor::AdaptiveBatchPublisher<TickEvent> publisher(ringBuffer, neverDue());
+    // 消费者停滞：批次目标按 1, 2, 4, ... 64 增长
+    for (long i = 0; i < 500; ++i)
+    {
+        publishValue(publisher, i);
+        REQUIRE(ringBuffer.getCursor() >= i - 64);
+    }
+    REQUIRE(publisher.getTargetBatchSize() == 64);
+    // 1 + 1 + 2 + 4 + ... + 64 = 128 events in 8 batches, then 64 per batch
+    REQUIRE(publisher.getPublishedBatchCount() == 8 + (500 - 128) / 64);
+    REQUIRE(ringBuffer.getCursor() == 500 - (500 - 128) % 64 - 1);
+
+    // 消费者追上后，下一个事件立即发布，批次目标缩小
+    consumer.set(ringBuffer.getCursor());
+    publishValue(publisher, 500);
+    REQUIRE(ringBuffer.getCursor() == 500);
+    REQUIRE(publisher.getPendingCount() == 0);
+    REQUIRE(publisher.getTargetBatchSize() == 32);
+    for (long i = 0; i <= 500; ++i)
+    {
+        REQUIRE(ringBuffer.get(i).value == i);
+    }
+}
+
+TEST_CASE("AdaptiveBatchPublisher never holds an event past maxDelay", "[adaptive_publisher]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<TickEvent>::createSingleProducer([] { return TickEvent{}; }, 256, waitStrategy);
+    disruptor::Sequence consumer{disruptor::Sequence::INITIAL_VALUE};
+    ringBuffer.addGatingSequences({&consumer});
+
+    disruptor::AdaptiveBatchPolicy policy;
+    policy.minBatch = 16;
+    policy.maxDelay = std::chrono::milliseconds(20);
+    disruptor::AdaptiveBatchPublisher<TickEvent> publisher(ringBuffer, policy);
+
+    publishValue(publisher, 0);  // consumer idle: published at once
+    REQUIRE(ringBuffer.getCursor() == 0);
+    publishValue(publisher, 1);  // consumer busy with 0: held
+    publishValue(publisher, 2);
+    REQUIRE(ringBuffer.getCursor() == 0);
+    REQUIRE(publisher.getPendingCount() == 2);
+    REQUIRE_FALSE(publisher.flushIfDue());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    REQUIRE(publisher.flushIfDue());
+    REQUIRE(ringBuffer.getCursor() == 2);
+
+    // 超时也在 commit() 时检查
+    publishValue(publisher, 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    publishValue(publisher, 4);
+    REQUIRE(ringBuffer.getCursor() == 4);
+
+    // 消费者追上后 flushIfDue() 立即发布
+    publishValue(publisher, 5);
+    REQUIRE(ringBuffer.getCursor() == 4);
+    consumer.set(4);
+    REQUIRE(publisher.flushIfDue());
+    REQUIRE(ringBuffer.getCursor() == 5);
+}
+
+TEST_CASE("AdaptiveBatchPublisher delivers every event in order to a live consumer", "[adaptive_publisher]")
+{
+    constexpr long events = 200'000;
+
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<TickEvent>::createSingleProducer([] { return TickEvent{}; }, 1024, waitStrategy);
+
+    struct OrderCheckingHandler final : disruptor::EventHandler<TickEvent>
+    {
+        void onEvent(TickEvent& event, long sequence, bool) override
+        {
+            ordered = ordered && event.value == sequence;
+            seen.store(sequence, std::memory_order_release);
+        }
+        bool ordered = true;
+        std::atomic<long> seen{-1};
+    } handler;
+
+    auto barrier = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<TickEvent> processor(ringBuffer, barrier, handler);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+    std::thread consumer([&] { processor.run(); });
+
+    {
+        disruptor::AdaptiveBatchPublisher<TickEvent> publisher(ringBuffer);
+        for (long i = 0; i < events; ++i)
+        {
+            publishValue(publisher, i);
+            if (i % 10'000 == 0)
+            {
+                // 间歇停顿：剩余事件由 flushIfDue() 发布
+                while (ringBuffer.getCursor() < i)
+                {
+                    publisher.flushIfDue();
+                }
+            }
+        }
+    }  // 析构时刷新
+
+    while (handler.seen.load(std::memory_order_acquire) < events - 1)
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(handler.ordered);
+}
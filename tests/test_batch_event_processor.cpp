@@ -1,7 +1,9 @@
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <stdexcept>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -488,3 +490,317 @@ TEST_CASE("BatchEventProcessor should process remaining events before halt", "[p
 
     REQUIRE(handler.processedCount.load() == events);
 }
+
+class ThrowAtSequenceHandler final : public disruptor::EventHandler<ProcessorEvent>
+{
+public:
+    void onEvent(ProcessorEvent&, long sequence, bool) override
+    {
+        if (sequence == 5)
+        {
+            throw std::runtime_error("mid-batch error");
+        }
+        seen.push_back(sequence);
+        processedCount.fetch_add(1, std::memory_order_release);
+    }
+
+    std::vector<long> seen;
+    std::atomic<long> processedCount{0};
+};
+
+class RecordingExceptionHandler final : public disruptor::ExceptionHandler<ProcessorEvent>
+{
+public:
+    void handleEventException(std::exception_ptr, long sequence, ProcessorEvent*) override
+    {
+        failed.push_back(sequence);
+    }
+    void handleOnStartException(std::exception_ptr) override {}
+    void handleOnShutdownException(std::exception_ptr) override {}
+
+    std::vector<long> failed;
+};
+
+TEST_CASE("BatchEventProcessor reports the failing sequence and skips only that event", "[processor][exception]")
+{
+    constexpr long events = 10;
+
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<ProcessorEvent>::createSingleProducer(
+        [] { return ProcessorEvent{}; }, 64, waitStrategy);
+
+    auto barrier = ringBuffer.newBarrier();
+    ThrowAtSequenceHandler handler;
+    RecordingExceptionHandler exceptionHandler;
+    disruptor::BatchEventProcessor<ProcessorEvent> processor(ringBuffer, barrier, handler);
+    processor.setExceptionHandler(exceptionHandler);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    // 一次发布整批事件，异常发生在批次中间
+    long hi = ringBuffer.next(static_cast<int>(events));
+    ringBuffer.publish(hi - events + 1, hi);
+
+    std::thread consumer([&] { processor.run(); });
+    while (handler.processedCount.load(std::memory_order_acquire) < events - 1)
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(exceptionHandler.failed == std::vector<long>{5});
+    REQUIRE(handler.seen == std::vector<long>{0, 1, 2, 3, 4, 6, 7, 8, 9});
+}
+
+struct StampedEvent
+{
+    long value{0};
+    int64_t publishedAt{0};
+};
+
+class StampedCollector final : public disruptor::EventHandler<StampedEvent>
+{
+public:
+    void onEvent(StampedEvent& event, long, bool) override
+    {
+        values.push_back(event.value);
+    }
+
+    std::vector<long> values;
+};
+
+TEST_CASE("BatchEventProcessor skips expired events in bulk", "[processor][ttl]")
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<StampedEvent>::createSingleProducer(
+        [] { return StampedEvent{}; }, 256, waitStrategy);
+
+    auto barrier = ringBuffer.newBarrier();
+    StampedCollector handler;
+    disruptor::BatchEventProcessor<StampedEvent> processor(ringBuffer, barrier, handler);
+    processor.setTimeToLive(std::chrono::milliseconds(100), [](const StampedEvent& e) { return e.publishedAt; });
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    // 积压：前 100 个事件已超过 TTL，后 50 个是新的
+    const int64_t now = disruptor::steadyClockNanos();
+    for (long i = 0; i < 150; ++i)
+    {
+        long seq = ringBuffer.next();
+        auto& event = ringBuffer.get(seq);
+        event.value = i;
+        event.publishedAt = i < 100 ? now - 1'000'000'000 + i : now;
+        ringBuffer.publish(seq);
+    }
+
+    std::thread consumer([&] { processor.run(); });
+    while (processor.getSequence().get() < 149)
+    {
+        std::this_thread::yield();
+    }
+
+    // 新事件不过期，照常处理
+    long seq = ringBuffer.next();
+    ringBuffer.get(seq) = StampedEvent{150, disruptor::steadyClockNanos()};
+    ringBuffer.publish(seq);
+    while (processor.getSequence().get() < 150)
+    {
+        std::this_thread::yield();
+    }
+
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(processor.getExpiredCount() == 100);
+    REQUIRE(handler.values.size() == 51);
+    REQUIRE(handler.values.front() == 100);
+    REQUIRE(handler.values.back() == 150);
+}
+
+class StampedExceptionRecorder final : public disruptor::ExceptionHandler<StampedEvent>
+{
+public:
+    void handleEventException(std::exception_ptr, long sequence, StampedEvent* event) override
+    {
+        failed.emplace_back(sequence, event);
+    }
+    void handleOnStartException(std::exception_ptr) override {}
+    void handleOnShutdownException(std::exception_ptr) override {}
+
+    std::vector<std::pair<long, StampedEvent*>> failed;
+};
+
+TEST_CASE("BatchEventProcessor reports a throwing publish stamp against its own event", "[processor][ttl][exception]")
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<StampedEvent>::createSingleProducer(
+        [] { return StampedEvent{}; }, 16, waitStrategy);
+
+    auto barrier = ringBuffer.newBarrier();
+    StampedCollector handler;
+    StampedExceptionRecorder exceptionHandler;
+    disruptor::BatchEventProcessor<StampedEvent> processor(ringBuffer, barrier, handler);
+    processor.setExceptionHandler(exceptionHandler);
+    processor.setTimeToLive(std::chrono::seconds(1), [](const StampedEvent& e) {
+        if (e.value == 3)
+        {
+            throw std::runtime_error("bad stamp");
+        }
+        return e.publishedAt;
+    });
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    auto publish = [&](long value) {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq) = StampedEvent{value, disruptor::steadyClockNanos()};
+        ringBuffer.publish(seq);
+    };
+
+    std::thread consumer([&] { processor.run(); });
+    for (long i = 0; i < 3; ++i)
+    {
+        publish(i);
+    }
+    while (processor.getSequence().get() < 2)
+    {
+        std::this_thread::yield();
+    }
+
+    // 新批次的第一个事件取时间戳时抛出：上报的事件必须是它，而不是上一批的最后一个
+    publish(3);
+    publish(4);
+    while (processor.getSequence().get() < 4)
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(exceptionHandler.failed.size() == 1);
+    REQUIRE(exceptionHandler.failed[0].first == 3);
+    REQUIRE(exceptionHandler.failed[0].second == &ringBuffer.get(3));
+    REQUIRE(handler.values == std::vector<long>{0, 1, 2, 4});
+}
+
+class LatestValueHandler final : public disruptor::EventHandler<ProcessorEvent>
+{
+public:
+    void onEvent(ProcessorEvent& event, long, bool) override
+    {
+        latest = event.value;
+        ++perEvent;
+        done.store(latest, std::memory_order_release);
+    }
+
+    void onBatchStart(long lo, long hi, long lag) override
+    {
+        batches.push_back({lo, hi, lag});
+    }
+
+    bool onCatchUp(disruptor::EventRange<ProcessorEvent>& backlog) override
+    {
+        // 只关心最新值：直接取积压区间的最后一个事件
+        latest = backlog[backlog.last()].value;
+        catchUpSizes.push_back(backlog.size());
+        done.store(latest, std::memory_order_release);
+        return true;
+    }
+
+    struct Batch
+    {
+        long lo;
+        long hi;
+        long lag;
+    };
+
+    long latest = -1;
+    long perEvent = 0;
+    std::vector<Batch> batches;
+    std::vector<long> catchUpSizes;
+    std::atomic<long> done{-1};
+};
+
+TEST_CASE("BatchEventProcessor hands large backlogs to onCatchUp", "[processor][catchup]")
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<ProcessorEvent>::createSingleProducer(
+        [] { return ProcessorEvent{}; }, 256, waitStrategy);
+
+    auto barrier = ringBuffer.newBarrier();
+    LatestValueHandler handler;
+    disruptor::BatchEventProcessor<ProcessorEvent> processor(ringBuffer, barrier, handler);
+    processor.setCatchUpThreshold(32);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    // 消费者启动前积压 200 个事件
+    for (long i = 0; i < 200; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq).value = i;
+        ringBuffer.publish(seq);
+    }
+
+    std::thread consumer([&] { processor.run(); });
+    while (handler.done.load(std::memory_order_acquire) < 199)
+    {
+        std::this_thread::yield();
+    }
+
+    // 追上之后逐个事件处理
+    for (long i = 200; i < 205; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq).value = i;
+        ringBuffer.publish(seq);
+        while (handler.done.load(std::memory_order_acquire) < i)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(handler.catchUpSizes == std::vector<long>{200});
+    REQUIRE(processor.getCatchUpCount() == 1);
+    REQUIRE(handler.perEvent == 5);
+    REQUIRE(handler.latest == 204);
+    REQUIRE(handler.batches.front().lo == 0);
+    REQUIRE(handler.batches.front().hi == 199);
+    REQUIRE(handler.batches.front().lag == 200);
+    REQUIRE(handler.batches.back().lag == 1);
+}
+
+TEST_CASE("BatchEventProcessor coalesces wakeups with a watermark", "[processor][watermark]")
+{
+    constexpr long events = 100;
+
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<ProcessorEvent>::createSingleProducer(
+        [] { return ProcessorEvent{}; }, 256, waitStrategy);
+
+    auto barrier = ringBuffer.newBarrier();
+    SequenceTrackingHandler handler;
+    disruptor::BatchEventProcessor<ProcessorEvent> processor(ringBuffer, barrier, handler);
+    processor.setWakeupWatermark(25, std::chrono::seconds(5));
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    std::thread consumer([&] { processor.run(); });
+
+    // 慢速逐个发布：每个批次至少 25 个事件，而不是每次发布唤醒一次
+    for (long i = 0; i < events; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq).value = i;
+        ringBuffer.publish(seq);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    while (handler.lastSequence.load() < events - 1)
+    {
+        std::this_thread::yield();
+    }
+
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(handler.batchEndCount.load() <= events / 25);
+}
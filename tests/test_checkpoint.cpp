@@ -0,0 +1,252 @@
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/checkpoint.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+struct CheckpointEvent
+{
+    long value{0};
+};
+
+// SequenceCheckpointTest - 测试消费者序列的持久化检查点与重启恢复
+
+namespace
+{
+std::string checkpointTempPath(const char* name)
+{
+    auto path = std::string("/tmp/disruptor_test_") + name + "_" + std::to_string(::getpid()) + ".ckp";
+    std::remove(path.c_str());
+    return path;
+}
+
+class RecordingHandler final : public disruptor::EventHandler<CheckpointEvent>
+{
+public:
+    void onEvent(CheckpointEvent&, long sequence, bool) override
+    {
+        sequences.push_back(sequence);
+        count.store(static_cast<long>(sequences.size()), std::memory_order_release);
+    }
+
+    std::vector<long> sequences;
+    std::atomic<long> count{0};
+};
+}
+
+TEST_CASE("SequenceCheckpoint persists tracked sequences across reopen", "[checkpoint]")
+{
+    const auto path = checkpointTempPath("ckp_reopen");
+    {
+        disruptor::SequenceCheckpoint checkpoint(path);
+        disruptor::Sequence consumer(41);
+        disruptor::Sequence gating(17);
+        checkpoint.track("consumer", consumer);
+        checkpoint.track("gating", gating);
+
+        consumer.set(99);
+        checkpoint.checkpointNow();
+        REQUIRE(checkpoint.getCheckpoint("consumer") == 99);
+        REQUIRE(checkpoint.getCheckpoint("gating") == 17);
+    }
+
+    disruptor::SequenceCheckpoint reopened(path);
+    disruptor::Sequence restored;
+    REQUIRE(reopened.restore("consumer", restored));
+    REQUIRE(restored.get() == 99);
+    REQUIRE(reopened.restore("gating", restored));
+    REQUIRE(restored.get() == 17);
+
+    disruptor::Sequence untouched(5);
+    REQUIRE_FALSE(reopened.restore("unknown", untouched));
+    REQUIRE(untouched.get() == 5);
+    REQUIRE(reopened.getCheckpoint("unknown") == disruptor::Sequence::INITIAL_VALUE);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("SequenceCheckpoint thread checkpoints periodically and on stop", "[checkpoint]")
+{
+    const auto path = checkpointTempPath("ckp_periodic");
+    disruptor::SequenceCheckpoint checkpoint(path, std::chrono::milliseconds(1), false);
+    disruptor::Sequence sequence;
+    checkpoint.track("worker", sequence);
+    checkpoint.start();
+
+    sequence.set(10);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (checkpoint.getCheckpoint("worker") != 10 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(checkpoint.getCheckpoint("worker") == 10);
+
+    sequence.set(20);
+    checkpoint.stop();
+    REQUIRE(checkpoint.getCheckpoint("worker") == 20);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("BatchEventProcessor resumes after its checkpointed sequence", "[checkpoint]")
+{
+    const auto path = checkpointTempPath("ckp_resume");
+    {
+        disruptor::SequenceCheckpoint checkpoint(path);
+        disruptor::Sequence previousRun(49);
+        checkpoint.track("processor", previousRun);
+        checkpoint.checkpointNow();
+    }
+
+    disruptor::SequenceCheckpoint checkpoint(path);
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<CheckpointEvent>::createSingleProducer(
+        [] { return CheckpointEvent{}; }, 16, waitStrategy);
+    auto barrier = ringBuffer.newBarrier();
+    RecordingHandler handler;
+    disruptor::BatchEventProcessor<CheckpointEvent> processor(ringBuffer, barrier, handler);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    REQUIRE(checkpoint.restore("processor", processor.getSequence()));
+    ringBuffer.resetTo(processor.getSequence().get());
+    checkpoint.track("processor", processor.getSequence());
+
+    std::thread consumer([&] { processor.run(); });
+    for (int i = 0; i < 10; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq).value = seq;
+        ringBuffer.publish(seq);
+    }
+    while (handler.count.load(std::memory_order_acquire) < 10)
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(handler.sequences.front() == 50);
+    REQUIRE(handler.sequences.back() == 59);
+    checkpoint.checkpointNow();
+    REQUIRE(checkpoint.getCheckpoint("processor") == 59);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("SequenceCheckpoint rejects invalid names and a full file", "[checkpoint]")
+{
+    const auto path = checkpointTempPath("ckp_full");
+    disruptor::SequenceCheckpoint checkpoint(path, std::chrono::milliseconds(100), false, 1);
+    disruptor::Sequence a;
+    disruptor::Sequence b;
+    REQUIRE_THROWS_AS(checkpoint.track("", a), std::invalid_argument);
+    checkpoint.track("a", a);
+    REQUIRE_THROWS_AS(checkpoint.track("b", b), std::length_error);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("SequenceCheckpoint rejects a truncated file", "[checkpoint]")
+{
+    const auto path = checkpointTempPath("ckp_truncated");
+    {
+        disruptor::SequenceCheckpoint checkpoint(path, std::chrono::milliseconds(100), false, 4);
+    }
+    // 头部仍声明 4 个槽位，但文件只剩一个槽位的长度；映射后访问会触发 SIGBUS
+    REQUIRE(::truncate(path.c_str(), sizeof(disruptor::CheckpointHeader) + sizeof(disruptor::CheckpointSlot)) == 0);
+
+    REQUIRE_THROWS_AS(disruptor::SequenceCheckpoint(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("SequenceCheckpoint rejects a header claiming more slots than it holds", "[checkpoint]")
+{
+    const auto path = checkpointTempPath("ckp_corrupt");
+    {
+        disruptor::SequenceCheckpoint checkpoint(path, std::chrono::milliseconds(100), false, 4);
+    }
+    // slotCount 超过 maxSlots：findSlot 会越过映射区域
+    const uint32_t slotCount = 5;
+    std::FILE* f = std::fopen(path.c_str(), "r+b");
+    REQUIRE(f != nullptr);
+    std::fseek(f, static_cast<long>(offsetof(disruptor::CheckpointHeader, slotCount)), SEEK_SET);
+    REQUIRE(std::fwrite(&slotCount, sizeof(slotCount), 1, f) == 1);
+    std::fclose(f);
+
+    REQUIRE_THROWS_AS(disruptor::SequenceCheckpoint(path), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+namespace
+{
+class FailingCheckpoint final : public disruptor::SequenceCheckpoint
+{
+public:
+    using SequenceCheckpoint::SequenceCheckpoint;
+
+    ~FailingCheckpoint() override
+    {
+        try
+        {
+            stop();
+        }
+        catch (const std::runtime_error&)
+        {
+        }
+    }
+
+    std::atomic<bool> failing{false};
+    std::atomic<int> failures{0};
+
+protected:
+    int syncMapping(void* address, size_t length) override
+    {
+        if (failing.load())
+        {
+            failures.fetch_add(1);
+            errno = EIO;
+            return -1;
+        }
+        return SequenceCheckpoint::syncMapping(address, length);
+    }
+};
+}
+
+TEST_CASE("SequenceCheckpoint rethrows an msync failure from the checkpoint thread", "[checkpoint]")
+{
+    const auto path = checkpointTempPath("ckp_msync");
+    FailingCheckpoint checkpoint(path, std::chrono::milliseconds(1), true, 4);
+    disruptor::Sequence sequence{5};
+    checkpoint.track("processor", sequence);
+    checkpoint.start();
+
+    checkpoint.failing.store(true);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (checkpoint.failures.load() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    REQUIRE(checkpoint.failures.load() == 1);
+
+    // 失败是粘滞的：后台线程停止同步，调用方线程上重新抛出
+    REQUIRE_THROWS_AS(checkpoint.stop(), std::runtime_error);
+    REQUIRE_THROWS_AS(checkpoint.checkpointNow(), std::runtime_error);
+    REQUIRE(checkpoint.failures.load() == 1);
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,176 @@
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/combining_publisher.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+struct RequestEvent
+{
+    int producer{0};
+    long value{0};
+};
+
+// CombiningPublisherTest - 测试扁平合并发布：多个低速生产者经由合并者批量申请与发布
+
+namespace
+{
+class PerProducerOrderHandler final : public disruptor::EventHandler<RequestEvent>
+{
+public:
+    explicit PerProducerOrderHandler(int producers) : next_(static_cast<size_t>(producers), 0) {}
+
+    void onEvent(RequestEvent& event, long, bool) override
+    {
+        long& expected = next_[static_cast<size_t>(event.producer)];
+        ordered = ordered && event.value == expected;
+        ++expected;
+        seen.fetch_add(1, std::memory_order_release);
+    }
+
+    bool ordered = true;
+    std::atomic<long> seen{0};
+
+private:
+    std::vector<long> next_;
+};
+
+void runCombining(disruptor::RingBuffer<RequestEvent>& ringBuffer, int producers, long perProducer)
+{
+    disruptor::CombiningPublisher<RequestEvent> publisher(ringBuffer, producers);
+
+    PerProducerOrderHandler handler(producers);
+    auto barrier = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<RequestEvent> processor(ringBuffer, barrier, handler);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+    std::thread consumer([&] { processor.run(); });
+
+    std::atomic<int> misplaced{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p] {
+            auto producer = publisher.producer();
+            for (long i = 0; i < perProducer; ++i)
+            {
+                long seq = producer.publish([&](RequestEvent& event) {
+                    event.producer = p;
+                    event.value = i;
+                });
+                // 返回的序号指向本生产者的事件（环足够大，尚未被覆盖）
+                const RequestEvent& published = ringBuffer.get(seq);
+                if (seq < 0 || (ringBuffer.getCursor() - seq < ringBuffer.getBufferSize() / 2 &&
+                                (published.producer != p || published.value != i)))
+                {
+                    misplaced.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    while (handler.seen.load(std::memory_order_acquire) < producers * perProducer)
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(handler.ordered);
+    REQUIRE(misplaced.load() == 0);
+    REQUIRE(publisher.getPublishedCount() == producers * perProducer);
+    REQUIRE(publisher.getCombineCount() >= 1);
+    REQUIRE(publisher.getCombineCount() <= producers * perProducer);
+    REQUIRE(ringBuffer.getCursor() == producers * perProducer - 1);
+}
+}
+
+TEST_CASE("CombiningPublisher publishes every request from many threads on a multi-producer ring",
+          "[combining_publisher]")
+{
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<RequestEvent>::createMultiProducer([] { return RequestEvent{}; }, 4096, waitStrategy);
+    runCombining(ringBuffer, 16, 2000);
+}
+
+TEST_CASE("CombiningPublisher serialises producers onto a single-producer ring", "[combining_publisher]")
+{
+    // 合并者一次只有一个，因此单生产者环也安全
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<RequestEvent>::createSingleProducer([] { return RequestEvent{}; }, 4096, waitStrategy);
+    runCombining(ringBuffer, 8, 2000);
+}
+
+TEST_CASE("CombiningPublisher from one thread publishes one event per pass", "[combining_publisher]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<std::string>::createMultiProducer([] { return std::string(); }, 16, waitStrategy);
+    disruptor::CombiningPublisher<std::string> publisher(ringBuffer, 2);
+    auto producer = publisher.producer();
+
+    for (long i = 0; i < 10; ++i)
+    {
+        REQUIRE(producer.publish([&](std::string& event) { event = "request-" + std::to_string(i); }) == i);
+    }
+
+    REQUIRE(ringBuffer.get(9) == "request-9");
+    REQUIRE(ringBuffer.getHighestPublishedSequence(0, 9) == 9);
+    REQUIRE(publisher.getCombineCount() == 10);
+}
+
+TEST_CASE("CombiningPublisher rejects more producers than request slots", "[combining_publisher]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<RequestEvent>::createMultiProducer([] { return RequestEvent{}; }, 8, waitStrategy);
+
+    REQUIRE_THROWS_AS(disruptor::CombiningPublisher<RequestEvent>(ringBuffer, 0), std::invalid_argument);
+    REQUIRE_THROWS_AS(disruptor::CombiningPublisher<RequestEvent>(ringBuffer, 9), std::invalid_argument);
+
+    disruptor::CombiningPublisher<RequestEvent> publisher(ringBuffer, 2);
+    [[maybe_unused]] auto first = publisher.producer();
+    [[maybe_unused]] auto second = publisher.producer();
+    REQUIRE_THROWS_AS(publisher.producer(), std::out_of_range);
+}
+
+TEST_CASE("CombiningPublisher reuses the slot of a destroyed producer", "[combining_publisher]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<RequestEvent>::createMultiProducer([] { return RequestEvent{}; }, 64, waitStrategy);
+    disruptor::CombiningPublisher<RequestEvent> publisher(ringBuffer, 2);
+
+    // 注册/销毁循环次数远超 maxProducers，槽位被回收复用
+    auto resident = publisher.producer();
+    long expected = 0;
+    for (int round = 0; round < 100; ++round)
+    {
+        auto transient = publisher.producer();
+        REQUIRE_THROWS_AS(publisher.producer(), std::out_of_range);
+        REQUIRE(transient.publish([&](RequestEvent& event) { event.value = round; }) == expected++);
+        REQUIRE(resident.publish([&](RequestEvent& event) { event.value = -round; }) == expected++);
+    }
+
+    // 移动后的句柄不会重复归还槽位
+    {
+        auto moved = publisher.producer();
+        auto target = std::move(moved);
+        REQUIRE(target.publish([](RequestEvent& event) { event.value = 7; }) == expected++);
+    }
+    auto a = publisher.producer();
+    REQUIRE_THROWS_AS(publisher.producer(), std::out_of_range);
+
+    REQUIRE(publisher.getPublishedCount() == expected);
+    REQUIRE(ringBuffer.getCursor() == expected - 1);
+}
@@ -0,0 +1,173 @@
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/concurrent_batch_publisher.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+struct IngestEvent
+{
+    int producer{0};
+    long value{0};
+};
+
+// ConcurrentBatchPublisherTest - 测试多生产者环上的每线程批量发布句柄
+
+namespace
+{
+/**
+ * Checks that each producer's events arrive complete and in its own order.
+ */
+class PerProducerOrderHandler final : public disruptor::EventHandler<IngestEvent>
+{
+public:
+    explicit PerProducerOrderHandler(int producers) : next_(static_cast<size_t>(producers), 0) {}
+
+    void onEvent(IngestEvent& event, long, bool) override
+    {
+        long& expected = next_[static_cast<size_t>(event.producer)];
+        ordered = ordered && event.value == expected;
+        ++expected;
+        seen.fetch_add(1, std::memory_order_release);
+    }
+
+    bool ordered = true;
+    std::atomic<long> seen{0};
+
+private:
+    std::vector<long> next_;
+};
+
+template <typename Publish>
+void runProducers(int producers, long perProducer, Publish publish)
+{
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<IngestEvent>::createMultiProducer([] { return IngestEvent{}; }, 1024, waitStrategy);
+    disruptor::ConcurrentBatchPublisher<IngestEvent> publisher(ringBuffer, 64);
+
+    PerProducerOrderHandler handler(producers);
+    auto barrier = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<IngestEvent> processor(ringBuffer, barrier, handler);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+    std::thread consumer([&] { processor.run(); });
+
+    std::atomic<long> published{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back([&, p] {
+            auto handle = publisher.handle();
+            publish(handle, p, perProducer);
+            published.fetch_add(handle.getPublishedCount());
+        });
+    }
+    for (auto& t : threads)
+    {
+        t.join();
+    }
+    while (handler.seen.load(std::memory_order_acquire) < producers * perProducer)
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(handler.ordered);
+    REQUIRE(handler.seen.load() == producers * perProducer);
+    REQUIRE(published.load() == producers * perProducer);
+    REQUIRE(ringBuffer.getCursor() == producers * perProducer - 1);
+}
+}
+
+TEST_CASE("ConcurrentBatchPublisher stages and publishes batches from many threads", "[concurrent_batch_publisher]")
+{
+    // 1000 不是 64 的整数倍：最后一批为部分批次
+    runProducers(4, 1000, [](auto& handle, int producer, long count) {
+        for (long i = 0; i < count; ++i)
+        {
+            auto& event = handle.claim();
+            event.producer = producer;
+            event.value = i;
+        }
+        handle.publishBatch();
+        REQUIRE(handle.getBatchCount() == (count + 63) / 64);
+        REQUIRE(handle.getStagedCount() == 0);
+    });
+}
+
+TEST_CASE("ConcurrentBatchPublisher fills claimed ranges in place", "[concurrent_batch_publisher]")
+{
+    runProducers(3, 3000, [](auto& handle, int producer, long count) {
+        long value = 0;
+        while (value < count)
+        {
+            const int size = static_cast<int>(std::min<long>(count - value, 1 + value % 50));
+            handle.beginBatch(size);
+            for (int i = 0; i < size; ++i)
+            {
+                handle.getEvent(i).producer = producer;
+                handle.getEvent(i).value = value++;
+            }
+            handle.endBatch();
+        }
+    });
+}
+
+TEST_CASE("ConcurrentBatchPublisher tryPublishBatch keeps the stage when the ring is full",
+          "[concurrent_batch_publisher]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<IngestEvent>::createMultiProducer([] { return IngestEvent{}; }, 8, waitStrategy);
+    disruptor::Sequence stalledConsumer{disruptor::Sequence::INITIAL_VALUE};
+    ringBuffer.addGatingSequences({&stalledConsumer});
+
+    disruptor::ConcurrentBatchPublisher<IngestEvent> publisher(ringBuffer, 6);
+    auto handle = publisher.handle();
+    for (long i = 0; i < 6; ++i)
+    {
+        handle.claim().value = i;
+    }
+    REQUIRE(handle.tryPublishBatch());
+    for (long i = 6; i < 10; ++i)
+    {
+        handle.claim().value = i;
+    }
+    REQUIRE_FALSE(handle.tryPublishBatch());  // 只剩 2 个空位
+    REQUIRE(handle.getStagedCount() == 4);
+    REQUIRE(ringBuffer.getCursor() == 5);
+
+    stalledConsumer.set(5);
+    REQUIRE(handle.tryPublishBatch());
+    REQUIRE(ringBuffer.getCursor() == 9);
+    REQUIRE(ringBuffer.get(9).value == 9);
+    REQUIRE(ringBuffer.getHighestPublishedSequence(2, 9) == 9);
+}
+
+TEST_CASE("ConcurrentBatchPublisher swaps non-trivial events into the ring", "[concurrent_batch_publisher]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<std::string>::createMultiProducer([] { return std::string(); }, 16, waitStrategy);
+    disruptor::ConcurrentBatchPublisher<std::string> publisher(ringBuffer, 4);
+    auto handle = publisher.handle();
+
+    for (int i = 0; i < 10; ++i)
+    {
+        handle.claim() = "event-" + std::to_string(i);
+    }
+    handle.publishBatch();
+
+    REQUIRE(ringBuffer.getCursor() == 9);
+    for (int i = 0; i < 10; ++i)
+    {
+        REQUIRE(ringBuffer.get(i) == "event-" + std::to_string(i));
+    }
+    REQUIRE(handle.getBatchCount() == 3);
+}
@@ -1,6 +1,7 @@
 #include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -232,3 +233,118 @@ TEST_CASE("SequenceBarrier with YieldingWaitStrategy")
 
     producer.join();
 }
+
+// ========== Watermark waits ==========
+namespace
+{
+void publishOne(disruptor::RingBuffer<BarrierEvent>& ringBuffer, long value)
+{
+    long seq = ringBuffer.next();
+    ringBuffer.get(seq).value = value;
+    ringBuffer.publish(seq);
+}
+
+void checkWatermarkWait(disruptor::WaitStrategy& waitStrategy)
+{
+    auto ringBuffer = disruptor::RingBuffer<BarrierEvent>::createSingleProducer(
+        [] { return BarrierEvent{}; }, 64, waitStrategy);
+    auto barrier = ringBuffer.newBarrier();
+
+    // 逐个发布：消费者只在凑够 8 个事件时醒来
+    std::thread producer([&] {
+        for (long i = 0; i < 8; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            publishOne(ringBuffer, i);
+        }
+    });
+    long available = barrier.waitFor(0, 8, std::chrono::seconds(5));
+    producer.join();
+    REQUIRE(available == 7);
+
+    // 未达到水位线：截止时间到后返回已有的事件
+    publishOne(ringBuffer, 8);
+    publishOne(ringBuffer, 9);
+    auto start = std::chrono::steady_clock::now();
+    available = barrier.waitFor(8, 100, std::chrono::milliseconds(20));
+    auto waited = std::chrono::steady_clock::now() - start;
+    REQUIRE(available == 9);
+    REQUIRE(waited >= std::chrono::milliseconds(20));
+    REQUIRE(waited < std::chrono::seconds(2));
+
+    // 截止时间已过但没有事件：仍等待第一个事件
+    std::thread late([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        publishOne(ringBuffer, 10);
+    });
+    available = barrier.waitFor(10, 100, std::chrono::steady_clock::now());
+    late.join();
+    REQUIRE(available == 10);
+
+    // 警报可中断水位等待
+    std::thread alerter([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        barrier.alert();
+    });
+    REQUIRE_THROWS_AS(barrier.waitFor(11, 100, std::chrono::seconds(5)), disruptor::AlertException);
+    alerter.join();
+}
+}
+
+TEST_CASE("SequenceBarrier watermark wait with BlockingWaitStrategy", "[barrier][watermark]")
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    checkWatermarkWait(waitStrategy);
+}
+
+TEST_CASE("SequenceBarrier alert wakes a BlockingWaitStrategy watermark waiter", "[barrier][watermark]")
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<BarrierEvent>::createSingleProducer(
+        [] { return BarrierEvent{}; }, 64, waitStrategy);
+    auto barrier = ringBuffer.newBarrier();
+
+    // 游标低于水位线时发布不会唤醒等待者，但警报必须唤醒它；
+    // 截止时间已过而没有可用事件时等待不会自行返回
+    for (int round = 0; round < 5; ++round)
+    {
+        barrier.clearAlert();
+        std::thread alerter([&] {
+            std::this_thread::sleep_for(std::chrono::microseconds(300));
+            barrier.alert();
+        });
+        REQUIRE_THROWS_AS(barrier.waitFor(0, 100, std::chrono::seconds(5)), disruptor::AlertException);
+        alerter.join();
+    }
+}
+
+TEST_CASE("SequenceBarrier watermark wait with SleepingWaitStrategy", "[barrier][watermark]")
+{
+    disruptor::SleepingWaitStrategy waitStrategy;
+    checkWatermarkWait(waitStrategy);
+}
+
+TEST_CASE("SequenceBarrier watermark wait with YieldingWaitStrategy", "[barrier][watermark]")
+{
+    disruptor::YieldingWaitStrategy waitStrategy;
+    checkWatermarkWait(waitStrategy);
+}
+
+TEST_CASE("SequenceBarrier watermark wait with a multi-producer ring", "[barrier][watermark]")
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<BarrierEvent>::createMultiProducer(
+        [] { return BarrierEvent{}; }, 64, waitStrategy);
+    auto barrier = ringBuffer.newBarrier();
+
+    std::thread producer([&] {
+        for (long i = 0; i < 16; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            publishOne(ringBuffer, i);
+        }
+    });
+    long available = barrier.waitFor(0, 16, std::chrono::seconds(5));
+    producer.join();
+    REQUIRE(available == 15);
+}
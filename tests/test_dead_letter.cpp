@@ -0,0 +1,222 @@
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/dead_letter.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+#include "disruptor/worker_pool.h"
+
+struct OrderEvent
+{
+    long value{0};
+};
+
+using OrderLetter = disruptor::DeadLetter<OrderEvent>;
+
+// DeadLetterTest - 测试失败事件转入死信 RingBuffer 并按退避策略重试
+
+namespace
+{
+bool failsInMainStage(long value)
+{
+    return value % 100 == 7;
+}
+
+class FlakyHandler final : public disruptor::EventHandler<OrderEvent>, public disruptor::WorkHandler<OrderEvent>
+{
+public:
+    void onEvent(OrderEvent& event, long, bool) override
+    {
+        process(event);
+    }
+
+    void onEvent(OrderEvent& event, long) override
+    {
+        process(event);
+    }
+
+    std::atomic<long> processed{0};
+
+private:
+    void process(const OrderEvent& event)
+    {
+        if (failsInMainStage(event.value))
+        {
+            throw std::runtime_error("downstream unavailable");
+        }
+        processed.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+disruptor::RetryPolicy fastRetries()
+{
+    disruptor::RetryPolicy policy;
+    policy.maxAttempts = 3;
+    policy.initialBackoff = std::chrono::microseconds(50);
+    return policy;
+}
+}
+
+TEST_CASE("DeadLetterExceptionHandler hands failures to a retrying dead-letter consumer", "[dead_letter]")
+{
+    constexpr long events = 1000;
+
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<OrderEvent>::createSingleProducer([] { return OrderEvent{}; }, 128, waitStrategy);
+    auto deadLetters = disruptor::RingBuffer<OrderLetter>::createSingleProducer([] { return OrderLetter{}; }, 64,
+                                                                                  waitStrategy);
+
+    // Every second failing event recovers on its first retry; the rest never do.
+    std::mutex exhaustedMutex;
+    std::vector<OrderLetter> exhausted;
+    disruptor::DeadLetterRetryHandler<OrderEvent> retryHandler(
+        [](OrderEvent& event, long) {
+            if (event.value % 200 != 7)
+            {
+                throw std::runtime_error("still unavailable");
+            }
+        },
+        fastRetries(),
+        [&](OrderLetter& letter) {
+            std::lock_guard<std::mutex> lock(exhaustedMutex);
+            exhausted.push_back(letter);
+        });
+    auto deadLetterBarrier = deadLetters.newBarrier();
+    disruptor::BatchEventProcessor<OrderLetter> deadLetterProcessor(deadLetters, deadLetterBarrier, retryHandler);
+    deadLetters.addGatingSequences({&deadLetterProcessor.getSequence()});
+
+    FlakyHandler handler;
+    disruptor::DeadLetterExceptionHandler<OrderEvent> deadLetterHandler(deadLetters);
+    auto barrier = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<OrderEvent> processor(ringBuffer, barrier, handler);
+    processor.setExceptionHandler(deadLetterHandler);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    std::thread deadLetterConsumer([&] { deadLetterProcessor.run(); });
+    std::thread consumer([&] { processor.run(); });
+
+    for (long i = 0; i < events; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq).value = i;
+        ringBuffer.publish(seq);
+    }
+
+    while (processor.getSequence().get() < events - 1 ||
+           retryHandler.getRecoveredCount() + retryHandler.getExhaustedCount() < events / 100)
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    deadLetterProcessor.halt();
+    consumer.join();
+    deadLetterConsumer.join();
+
+    REQUIRE(handler.processed.load() == events - events / 100);
+    REQUIRE(deadLetterHandler.getDeadLetteredCount() == events / 100);
+    REQUIRE(deadLetterHandler.getDroppedCount() == 0);
+    REQUIRE(retryHandler.getRecoveredCount() == 5);
+    REQUIRE(retryHandler.getExhaustedCount() == 5);
+    // Recovered: one retry each. Exhausted: two retries after the original failure.
+    REQUIRE(retryHandler.getRetryCount() == 5 * 1 + 5 * 2);
+    for (const auto& letter : exhausted)
+    {
+        REQUIRE(letter.attempts == 3);
+        REQUIRE(letter.sequence == letter.event.value);
+        REQUIRE(letter.error == "still unavailable");
+    }
+}
+
+TEST_CASE("WorkerPool routes handler exceptions to a dead-letter ring", "[dead_letter]")
+{
+    constexpr long events = 2000;
+
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<OrderEvent>::createMultiProducer([] { return OrderEvent{}; }, 256, waitStrategy);
+    // Several workers publish failures, so the dead-letter ring is multi-producer.
+    auto deadLetters = disruptor::RingBuffer<OrderLetter>::createMultiProducer([] { return OrderLetter{}; }, 64,
+                                                                                 waitStrategy);
+
+    std::atomic<long> retried{0};
+    disruptor::DeadLetterRetryHandler<OrderEvent> retryHandler(
+        [&](OrderEvent&, long) { retried.fetch_add(1, std::memory_order_relaxed); }, fastRetries());
+    auto deadLetterBarrier = deadLetters.newBarrier();
+    disruptor::BatchEventProcessor<OrderLetter> deadLetterProcessor(deadLetters, deadLetterBarrier, retryHandler);
+    deadLetters.addGatingSequences({&deadLetterProcessor.getSequence()});
+
+    FlakyHandler first;
+    FlakyHandler second;
+    disruptor::DeadLetterExceptionHandler<OrderEvent> deadLetterHandler(deadLetters, true);
+    disruptor::WorkerPool<OrderEvent> pool(ringBuffer, {&first, &second});
+    pool.setExceptionHandler(deadLetterHandler);
+    ringBuffer.addGatingSequences(pool.getWorkerSequences());
+
+    std::thread deadLetterConsumer([&] { deadLetterProcessor.run(); });
+    pool.start();
+
+    for (long i = 0; i < events; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq).value = i;
+        ringBuffer.publish(seq);
+    }
+
+    while (first.processed.load() + second.processed.load() < events - events / 100 ||
+           retried.load() < events / 100)
+    {
+        std::this_thread::yield();
+    }
+    pool.halt();
+    pool.join();
+    deadLetterProcessor.halt();
+    deadLetterConsumer.join();
+
+    REQUIRE(deadLetterHandler.getDeadLetteredCount() == events / 100);
+    REQUIRE(retryHandler.getRecoveredCount() == events / 100);
+    REQUIRE(retryHandler.getExhaustedCount() == 0);
+}
+
+TEST_CASE("DeadLetterExceptionHandler drops instead of blocking when the dead-letter ring is full", "[dead_letter]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto deadLetters = disruptor::RingBuffer<OrderLetter>::createSingleProducer([] { return OrderLetter{}; }, 4,
+                                                                                  waitStrategy);
+    disruptor::Sequence stalledConsumer{disruptor::Sequence::INITIAL_VALUE};
+    deadLetters.addGatingSequences({&stalledConsumer});
+
+    disruptor::DeadLetterExceptionHandler<OrderEvent> deadLetterHandler(deadLetters);
+    auto exception = std::make_exception_ptr(std::runtime_error("bad"));
+    for (long i = 0; i < 10; ++i)
+    {
+        OrderEvent event{i};
+        deadLetterHandler.handleEventException(exception, i, &event);
+    }
+
+    REQUIRE(deadLetterHandler.getDeadLetteredCount() == 4);
+    REQUIRE(deadLetterHandler.getDroppedCount() == 6);
+    REQUIRE(deadLetters.get(3).event.value == 3);
+    REQUIRE(deadLetters.get(3).error == "bad");
+}
+
+TEST_CASE("RetryPolicy backs off exponentially up to the cap", "[dead_letter]")
+{
+    disruptor::RetryPolicy policy;
+    policy.initialBackoff = std::chrono::milliseconds(1);
+    policy.multiplier = 2.0;
+    policy.maxBackoff = std::chrono::milliseconds(5);
+
+    REQUIRE(policy.backoffAfter(1) == std::chrono::milliseconds(1));
+    REQUIRE(policy.backoffAfter(2) == std::chrono::milliseconds(2));
+    REQUIRE(policy.backoffAfter(3) == std::chrono::milliseconds(4));
+    REQUIRE(policy.backoffAfter(4) == std::chrono::milliseconds(5));
+    REQUIRE(policy.backoffAfter(40) == std::chrono::milliseconds(5));
+}
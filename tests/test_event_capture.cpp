@@ -0,0 +1,122 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/event_capture.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+struct CaptureEvent
+{
+    long value{0};
+    int type{0};
+};
+
+// EventCaptureTest - 测试事件捕获到二进制文件并回放到 RingBuffer 的功能
+
+namespace
+{
+std::string captureTempPath(const char* name)
+{
+    return std::string("/tmp/disruptor_test_") + name + "_" + std::to_string(::getpid()) + ".cap";
+}
+
+void captureEvents(const std::string& path, long events, std::chrono::microseconds gap = std::chrono::microseconds(0))
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<CaptureEvent>::createSingleProducer(
+        [] { return CaptureEvent{}; }, 64, waitStrategy);
+
+    auto barrier = ringBuffer.newBarrier();
+    disruptor::EventCaptureHandler<CaptureEvent> capture(path, 256);
+    disruptor::BatchEventProcessor<CaptureEvent> processor(ringBuffer, barrier, capture);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    std::thread consumer([&] { processor.run(); });
+
+    for (long i = 0; i < events; ++i)
+    {
+        if (gap.count() > 0)
+        {
+            std::this_thread::sleep_for(gap);
+        }
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq) = CaptureEvent{i, static_cast<int>(i % 3)};
+        ringBuffer.publish(seq);
+    }
+
+    while (processor.getSequence().get() < events - 1)
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(capture.getCapturedCount() == events);
+    capture.close();
+}
+}
+
+TEST_CASE("EventReplayer republishes captured events at maximum speed", "[capture]")
+{
+    constexpr long events = 1000;
+    const auto path = captureTempPath("max");
+    captureEvents(path, events);
+
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto target = disruptor::RingBuffer<CaptureEvent>::createSingleProducer(
+        [] { return CaptureEvent{}; }, 1024, waitStrategy);
+
+    disruptor::EventReplayer<CaptureEvent> replayer(path);
+    REQUIRE(replayer.replay(target, 0.0, 100) == events);
+    REQUIRE(target.getCursor() == events - 1);
+
+    for (long seq = 0; seq < events; ++seq)
+    {
+        REQUIRE(target.get(seq).value == seq);
+        REQUIRE(target.get(seq).type == static_cast<int>(seq % 3));
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("EventReplayer preserves scaled inter-event timing", "[capture]")
+{
+    constexpr long events = 10;
+    const auto path = captureTempPath("timed");
+    captureEvents(path, events, std::chrono::microseconds(2000));
+
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto target = disruptor::RingBuffer<CaptureEvent>::createSingleProducer(
+        [] { return CaptureEvent{}; }, 64, waitStrategy);
+
+    disruptor::EventReplayer<CaptureEvent> replayer(path);
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(replayer.replay(target, 2.0) == events);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // 9 gaps of >= 2ms captured, replayed at 2x => at least ~9ms
+    REQUIRE(elapsed >= std::chrono::milliseconds(8));
+    REQUIRE(target.get(events - 1).value == events - 1);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("EventReplayer rejects mismatched event types", "[capture]")
+{
+    const auto path = captureTempPath("mismatch");
+    captureEvents(path, 4);
+
+    REQUIRE_THROWS_AS(disruptor::EventReplayer<long>(path), std::runtime_error);
+    REQUIRE_THROWS_AS(disruptor::EventReplayer<CaptureEvent>("/nonexistent/dir/file.cap"), std::runtime_error);
+
+    std::remove(path.c_str());
+}
@@ -2,6 +2,7 @@
 #include <thread>
 #include <chrono>
 #include <stdexcept>
+#include <string>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -107,3 +108,56 @@ TEST_CASE("Lifecycle callbacks are invoked")
     REQUIRE(handler.shut.load(std::memory_order_relaxed));
     REQUIRE(handler.processed.load(std::memory_order_relaxed) == events);
 }
+
+TEST_CASE("IgnoreExceptionHandler deduplicates a burst of identical failures")
+{
+    disruptor::IgnoreExceptionHandler<ExceptionEvent> ignoreHandler;
+    ExceptionEvent event;
+    auto exception = std::make_exception_ptr(std::runtime_error("bad event"));
+
+    for (long seq = 0; seq < 1000; ++seq)
+    {
+        ignoreHandler.handleEventException(exception, seq, &event);
+    }
+    ignoreHandler.flush();
+
+    // Same call site and message: logged once, the rest only counted.
+    REQUIRE(ignoreHandler.getReportedCount() == 1);
+    REQUIRE(ignoreHandler.getSuppressedCount() == 999);
+}
+
+TEST_CASE("IgnoreExceptionHandler caps distinct reports per window")
+{
+    disruptor::IgnoreExceptionHandler<ExceptionEvent> ignoreHandler(std::chrono::seconds(10), 4);
+    ExceptionEvent event;
+
+    for (long seq = 0; seq < 20; ++seq)
+    {
+        auto exception = std::make_exception_ptr(std::runtime_error("failure " + std::to_string(seq)));
+        ignoreHandler.handleEventException(exception, seq, &event);
+    }
+    ignoreHandler.flush();
+
+    REQUIRE(ignoreHandler.getReportedCount() == 4);
+    REQUIRE(ignoreHandler.getSuppressedCount() == 16);
+}
+
+TEST_CASE("IgnoreExceptionHandler reports a repeated failure again after the window")
+{
+    disruptor::IgnoreExceptionHandler<ExceptionEvent> ignoreHandler(std::chrono::milliseconds(5));
+    ExceptionEvent event;
+    auto exception = std::make_exception_ptr(std::runtime_error("flaky"));
+
+    for (int round = 0; round < 2; ++round)
+    {
+        for (long seq = 0; seq < 10; ++seq)
+        {
+            ignoreHandler.handleEventException(exception, seq, &event);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ignoreHandler.flush();
+
+    REQUIRE(ignoreHandler.getReportedCount() == 2);
+    REQUIRE(ignoreHandler.getSuppressedCount() == 18);
+}
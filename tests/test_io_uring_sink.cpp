@@ -0,0 +1,179 @@
+#include <atomic>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/io_uring_sink.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+// IoUringFileSinkTest - 测试基于 io_uring 的批量文件写入阶段与完成序列门控
+
+#ifdef DISRUPTOR_HAS_IO_URING
+
+struct SinkEvent
+{
+    long value{0};
+    long padding{0};
+};
+
+namespace
+{
+std::string sinkTempPath(const char* name)
+{
+    return std::string("/tmp/disruptor_test_") + name + "_" + std::to_string(::getpid()) + ".bin";
+}
+
+std::unique_ptr<disruptor::IoUringFileSink<SinkEvent>> makeSink(disruptor::RingBuffer<SinkEvent>& ringBuffer,
+                                                               const std::string& path, unsigned depth)
+{
+    try
+    {
+        return std::make_unique<disruptor::IoUringFileSink<SinkEvent>>(ringBuffer, path, depth);
+    }
+    catch (const std::runtime_error& e)
+    {
+        // io_uring may be disabled (seccomp, sysctl kernel.io_uring_disabled).
+        WARN("io_uring unavailable: " << e.what());
+        return nullptr;
+    }
+}
+}
+
+TEST_CASE("IoUringFileSink writes every batch in order and gates producers on completion", "[io_uring]")
+{
+    constexpr long events = 5000;
+    const auto path = sinkTempPath("uring_sink");
+
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<SinkEvent>::createSingleProducer(
+        [] { return SinkEvent{}; }, 64, waitStrategy);
+    auto sink = makeSink(ringBuffer, path, 4);
+    if (!sink)
+    {
+        return;
+    }
+
+    auto barrier = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<SinkEvent> processor(ringBuffer, barrier, *sink);
+    ringBuffer.addGatingSequences({&sink->getCompletedSequence()});
+
+    std::thread consumer([&] { processor.run(); });
+    for (long i = 0; i < events; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq).value = i;
+        ringBuffer.publish(seq);
+    }
+    while (sink->getCompletedSequence().get() < events - 1)
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    consumer.join();
+
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    REQUIRE(f != nullptr);
+    std::vector<SinkEvent> written(events + 1);
+    REQUIRE(std::fread(written.data(), sizeof(SinkEvent), written.size(), f) == static_cast<size_t>(events));
+    std::fclose(f);
+
+    long mismatches = 0;
+    for (long i = 0; i < events; ++i)
+    {
+        mismatches += written[static_cast<size_t>(i)].value != i ? 1 : 0;
+    }
+    REQUIRE(mismatches == 0);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("IoUringFileSink writes the unfinished batch on shutdown", "[io_uring]")
+{
+    const auto path = sinkTempPath("uring_sink_partial");
+
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<SinkEvent>::createSingleProducer(
+        [] { return SinkEvent{}; }, 64, waitStrategy);
+    auto sink = makeSink(ringBuffer, path, 4);
+    if (!sink)
+    {
+        return;
+    }
+
+    // 直接驱动 handler：批次未结束（endOfBatch 从未为 true）时停止
+    constexpr long events = 5;
+    sink->onStart();
+    for (long i = 0; i < events; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq).value = i;
+        ringBuffer.publish(seq);
+        sink->onEvent(ringBuffer.get(seq), seq, false);
+    }
+    sink->onShutdown();
+    REQUIRE(sink->getCompletedSequence().get() == events - 1);
+
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    REQUIRE(f != nullptr);
+    std::vector<SinkEvent> written(events + 1);
+    REQUIRE(std::fread(written.data(), sizeof(SinkEvent), written.size(), f) == static_cast<size_t>(events));
+    std::fclose(f);
+    for (long i = 0; i < events; ++i)
+    {
+        REQUIRE(written[static_cast<size_t>(i)].value == i);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("IoUringFileSink keeps a failed write and stops completing after it", "[io_uring]")
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<SinkEvent>::createSingleProducer(
+        [] { return SinkEvent{}; }, 64, waitStrategy);
+    // /dev/full 上的每次写入都以 ENOSPC 失败
+    auto sink = makeSink(ringBuffer, "/dev/full", 4);
+    if (!sink)
+    {
+        return;
+    }
+
+    auto errorOf = [](auto&& call) {
+        try
+        {
+            call();
+        }
+        catch (const std::runtime_error& e)
+        {
+            return std::string(e.what());
+        }
+        return std::string();
+    };
+
+    sink->onStart();
+    long seq = 0;
+    for (; seq < 4; ++seq)
+    {
+        ringBuffer.publish(ringBuffer.next());
+        // 写入是异步的：错误可能在本批次或之后才抛出
+        errorOf([&] { sink->onEvent(ringBuffer.get(seq), seq, seq == 3); });
+    }
+    REQUIRE(errorOf([&] { sink->onShutdown(); }).find("io_uring write failed") != std::string::npos);
+    REQUIRE(sink->getCompletedSequence().get() == disruptor::Sequence::INITIAL_VALUE);
+
+    // 错误是粘滞的：之后的批次不再提交，并且每次都重新抛出
+    ringBuffer.publish(ringBuffer.next());
+    REQUIRE(errorOf([&] { sink->onEvent(ringBuffer.get(seq), seq, true); }).find("io_uring write failed") !=
+            std::string::npos);
+    REQUIRE(sink->getCompletedSequence().get() == disruptor::Sequence::INITIAL_VALUE);
+}
+
+#endif
@@ -0,0 +1,394 @@
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/journal.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+struct JournalEvent
+{
+    long value{0};
+    int type{0};
+};
+
+// JournalTest - 测试内存映射追加日志阶段的分段滚动、持久化策略与持久序列门控
+
+namespace
+{
+std::string journalTempDir(const char* name)
+{
+    auto dir = std::string("/tmp/disruptor_test_journal_") + name + "_" + std::to_string(::getpid());
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+std::vector<JournalEvent> readSegment(const std::string& path, disruptor::JournalSegmentHeader& header)
+{
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    REQUIRE(f != nullptr);
+    REQUIRE(std::fread(&header, sizeof(header), 1, f) == 1);
+    std::vector<JournalEvent> events(static_cast<size_t>(header.committedCount));
+    std::fseek(f, static_cast<long>(disruptor::JOURNAL_HEADER_BYTES), SEEK_SET);
+    REQUIRE(std::fread(events.data(), sizeof(JournalEvent), events.size(), f) == events.size());
+    std::fclose(f);
+    return events;
+}
+
+class CollectingHandler final : public disruptor::EventHandler<JournalEvent>
+{
+public:
+    void onEvent(JournalEvent& event, long, bool) override
+    {
+        values.push_back(event.value);
+        count.store(static_cast<long>(values.size()), std::memory_order_release);
+    }
+
+    std::vector<long> values;
+    std::atomic<long> count{0};
+};
+
+void journalEvents(disruptor::JournalHandler<JournalEvent>& journal, long events, CollectingHandler* downstream = nullptr)
+{
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<JournalEvent>::createSingleProducer(
+        [] { return JournalEvent{}; }, 64, waitStrategy);
+
+    auto journalBarrier = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<JournalEvent> journalProcessor(ringBuffer, journalBarrier, journal);
+
+    auto downstreamBarrier = ringBuffer.newBarrier({&journal.getDurableSequence()});
+    CollectingHandler unused;
+    disruptor::BatchEventProcessor<JournalEvent> downstreamProcessor(
+        ringBuffer, downstreamBarrier, downstream ? *downstream : unused);
+    ringBuffer.addGatingSequences({&downstreamProcessor.getSequence()});
+
+    std::thread journalThread([&] { journalProcessor.run(); });
+    std::thread downstreamThread;
+    if (downstream)
+    {
+        downstreamThread = std::thread([&] { downstreamProcessor.run(); });
+    }
+    else
+    {
+        ringBuffer.removeGatingSequence(&downstreamProcessor.getSequence());
+        ringBuffer.addGatingSequences({&journalProcessor.getSequence()});
+    }
+
+    for (long i = 0; i < events; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq) = JournalEvent{i * 10, static_cast<int>(i % 3)};
+        ringBuffer.publish(seq);
+    }
+
+    while (journalProcessor.getSequence().get() < events - 1)
+    {
+        std::this_thread::yield();
+    }
+    journalProcessor.halt();
+    journalThread.join();
+
+    if (downstream)
+    {
+        while (downstream->count.load(std::memory_order_acquire) < events)
+        {
+            std::this_thread::yield();
+        }
+        downstreamProcessor.halt();
+        downstreamThread.join();
+    }
+}
+}
+
+TEST_CASE("JournalHandler rolls pre-allocated segments and records every event", "[journal]")
+{
+    const auto dir = journalTempDir("roll");
+    disruptor::JournalConfig config;
+    config.directory = dir;
+    config.segmentRecords = 100;
+    config.durability = disruptor::JournalDurability::MsyncPerBatch;
+
+    constexpr long events = 250;
+    {
+        disruptor::JournalHandler<JournalEvent> journal(config);
+        journalEvents(journal, events);
+        REQUIRE(journal.getDurableSequence().get() == events - 1);
+    }
+
+    long expected = 0;
+    for (long first : {0L, 100L, 200L})
+    {
+        const auto path = disruptor::detail::journalSegmentPath(dir, "journal", first);
+        REQUIRE(std::filesystem::file_size(path) == disruptor::JOURNAL_HEADER_BYTES + 100 * sizeof(JournalEvent));
+
+        disruptor::JournalSegmentHeader header;
+        auto records = readSegment(path, header);
+        REQUIRE(header.firstSequence == first);
+        REQUIRE(header.capacity == 100);
+        REQUIRE(header.recordSize == sizeof(JournalEvent));
+        REQUIRE(header.committedCount == (first == 200 ? 50 : 100));
+        for (const auto& r : records)
+        {
+            REQUIRE(r.value == expected * 10);
+            ++expected;
+        }
+    }
+    REQUIRE(expected == events);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("JournalHandler durable sequence gates downstream consumers", "[journal]")
+{
+    const auto dir = journalTempDir("gate");
+    disruptor::JournalConfig config;
+    config.directory = dir;
+    config.segmentRecords = 64;
+    config.durability = disruptor::JournalDurability::FdatasyncInterval;
+    config.syncInterval = std::chrono::milliseconds(1);
+
+    constexpr long events = 500;
+    CollectingHandler downstream;
+    disruptor::JournalHandler<JournalEvent> journal(config);
+    journalEvents(journal, events, &downstream);
+
+    REQUIRE(journal.getDurableSequence().get() == events - 1);
+    REQUIRE(downstream.values.size() == static_cast<size_t>(events));
+    for (long i = 0; i < events; ++i)
+    {
+        REQUIRE(downstream.values[static_cast<size_t>(i)] == i * 10);
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("JournalHandler stops advancing the durable sequence after a failed fdatasync", "[journal]")
+{
+    const auto dir = journalTempDir("syncfail");
+    std::atomic<bool> failSync{false};
+    std::atomic<int> failures{0};
+    disruptor::JournalConfig config;
+    config.directory = dir;
+    config.segmentRecords = 1024;
+    config.durability = disruptor::JournalDurability::FdatasyncInterval;
+    config.syncInterval = std::chrono::milliseconds(1);
+    config.syncFile = [&](int fd) {
+        if (failSync.load())
+        {
+            failures.fetch_add(1);
+            errno = EIO;
+            return -1;
+        }
+        return ::fdatasync(fd);
+    };
+
+    disruptor::JournalHandler<JournalEvent> journal(config);
+    journal.onStart();
+    auto waitForDurable = [&](long sequence) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (journal.getDurableSequence().get() < sequence && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    long sequence = 0;
+    for (; sequence < 10; ++sequence)
+    {
+        JournalEvent event{sequence * 10, 0};
+        journal.onEvent(event, sequence, sequence == 9);
+    }
+    waitForDurable(9);
+    REQUIRE(journal.getDurableSequence().get() == 9);
+
+    // 刷盘失败：之后即使 fdatasync 再次成功，持久序列也不能越过丢失的页
+    failSync.store(true);
+    for (; sequence < 20; ++sequence)
+    {
+        JournalEvent event{sequence * 10, 0};
+        journal.onEvent(event, sequence, sequence == 19);
+    }
+    while (failures.load() == 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    failSync.store(false);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(journal.getDurableSequence().get() == 9);
+
+    // 错误在处理线程的下一次提交和 onShutdown 中抛出
+    auto errorOf = [](auto&& call) {
+        try
+        {
+            call();
+        }
+        catch (const std::runtime_error& e)
+        {
+            return std::string(e.what());
+        }
+        return std::string();
+    };
+    JournalEvent event{200, 0};
+    REQUIRE(errorOf([&] { journal.onEvent(event, 20, true); }).find("fdatasync failed") != std::string::npos);
+    REQUIRE(errorOf([&] { journal.onShutdown(); }).find("fdatasync failed") != std::string::npos);
+    REQUIRE(journal.getDurableSequence().get() == 9);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("JournalHandler rejects an empty segment size", "[journal]")
+{
+    disruptor::JournalConfig config;
+    config.directory = journalTempDir("invalid");
+    config.segmentRecords = 0;
+    REQUIRE_THROWS_AS(disruptor::JournalHandler<JournalEvent>(config), std::invalid_argument);
+}
+
+namespace
+{
+class SequenceCheckingHandler final : public disruptor::EventHandler<JournalEvent>
+{
+public:
+    void onEvent(JournalEvent& event, long sequence, bool) override
+    {
+        if (event.value != sequence * 10)
+        {
+            mismatches.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (first < 0)
+        {
+            first = sequence;
+        }
+        count.fetch_add(1, std::memory_order_release);
+    }
+
+    long first = -1;
+    std::atomic<long> count{0};
+    std::atomic<long> mismatches{0};
+};
+
+long replayInto(const std::string& dir, long fromSequence, SequenceCheckingHandler& handler)
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<JournalEvent>::createSingleProducer(
+        [] { return JournalEvent{}; }, 32, waitStrategy);
+    auto barrier = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<JournalEvent> processor(ringBuffer, barrier, handler);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    ringBuffer.resetTo(fromSequence - 1);
+    processor.getSequence().set(fromSequence - 1);
+
+    std::thread consumer([&] { processor.run(); });
+    disruptor::JournalReplayer<JournalEvent> replayer(dir);
+    long published = replayer.replay(ringBuffer, fromSequence, 16);
+
+    while (handler.count.load(std::memory_order_acquire) < published)
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(ringBuffer.getCursor() == replayer.getLastSequence());
+    return published;
+}
+}
+
+TEST_CASE("JournalReplayer rebuilds a ring from a given sequence with the journal's numbering", "[journal]")
+{
+    const auto dir = journalTempDir("replay");
+    disruptor::JournalConfig config;
+    config.directory = dir;
+    config.segmentRecords = 100;
+    {
+        disruptor::JournalHandler<JournalEvent> journal(config);
+        journalEvents(journal, 250);
+    }
+
+    disruptor::JournalReplayer<JournalEvent> replayer(dir);
+    REQUIRE(replayer.getSegments().size() == 3);
+    REQUIRE(replayer.getLastSequence() == 249);
+
+    SECTION("from the start")
+    {
+        SequenceCheckingHandler handler;
+        REQUIRE(replayInto(dir, 0, handler) == 250);
+        REQUIRE(handler.first == 0);
+        REQUIRE(handler.mismatches.load() == 0);
+    }
+
+    SECTION("from the middle of a segment")
+    {
+        SequenceCheckingHandler handler;
+        REQUIRE(replayInto(dir, 130, handler) == 120);
+        REQUIRE(handler.first == 130);
+        REQUIRE(handler.mismatches.load() == 0);
+    }
+
+    SECTION("rejects sequences the journal does not cover")
+    {
+        disruptor::BlockingWaitStrategy waitStrategy;
+        auto ringBuffer = disruptor::RingBuffer<JournalEvent>::createMultiProducer(
+            [] { return JournalEvent{}; }, 32, waitStrategy);
+        REQUIRE_THROWS_AS(replayer.replay(ringBuffer, 5), std::invalid_argument);
+        ringBuffer.resetTo(299);
+        REQUIRE_THROWS_AS(replayer.replay(ringBuffer, 301), std::invalid_argument);
+        ringBuffer.resetTo(300);
+        REQUIRE_THROWS_AS(replayer.replay(ringBuffer, 301), std::out_of_range);
+        REQUIRE(ringBuffer.next() == 301);
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("JournalReplayer rejects truncated and corrupt segments", "[journal]")
+{
+    const auto dir = journalTempDir("corrupt");
+    disruptor::JournalConfig config;
+    config.directory = dir;
+    config.segmentRecords = 100;
+    {
+        disruptor::JournalHandler<JournalEvent> journal(config);
+        journalEvents(journal, 150);
+    }
+    const auto segments = disruptor::JournalReplayer<JournalEvent>(dir).getSegments();
+    REQUIRE(segments.size() == 2);
+
+    SECTION("records cut off by a short file")
+    {
+        // 第二段提交了 50 条记录，文件却只剩 10 条；映射后读取会触发 SIGBUS
+        REQUIRE(::truncate(segments[1].path.c_str(),
+                           static_cast<off_t>(disruptor::JOURNAL_HEADER_BYTES + 10 * sizeof(JournalEvent))) == 0);
+        REQUIRE_THROWS_AS(disruptor::JournalReplayer<JournalEvent>(dir), std::runtime_error);
+    }
+
+    SECTION("a committed count outside the segment")
+    {
+        for (int64_t count : {int64_t(-1), int64_t(101)})
+        {
+            int fd = ::open(segments[0].path.c_str(), O_WRONLY);
+            REQUIRE(fd >= 0);
+            REQUIRE(::pwrite(fd, &count, sizeof(count), offsetof(disruptor::JournalSegmentHeader, committedCount)) ==
+                    static_cast<ssize_t>(sizeof(count)));
+            ::close(fd);
+            REQUIRE_THROWS_AS(disruptor::JournalReplayer<JournalEvent>(dir), std::runtime_error);
+        }
+    }
+
+    std::filesystem::remove_all(dir);
+}
@@ -0,0 +1,79 @@
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/logging_handler.h"
+
+struct LogEvent
+{
+    int type{0};
+    long value{0};
+};
+
+// LoggingHandlerTest - 测试日志消费阶段的按类型采样与限速
+
+namespace
+{
+auto makeRecordingLogger(std::vector<long>& logged, size_t typeCount, disruptor::LogSamplingPolicy policy = {})
+{
+    return disruptor::makeLoggingHandler<LogEvent>(
+        [&logged](const LogEvent& event, long) { logged.push_back(event.value); },
+        [](const LogEvent& event) { return static_cast<size_t>(event.type); }, typeCount, policy);
+}
+}
+
+TEST_CASE("LoggingHandler samples one event in N per type", "[logging]")
+{
+    std::vector<long> logged;
+    auto logger = makeRecordingLogger(logged, 2);
+    logger.setPolicy(1, {4, 0});
+
+    for (long i = 0; i < 100; ++i)
+    {
+        LogEvent event{static_cast<int>(i % 2), i};
+        logger.onEvent(event, i, i % 10 == 9);
+    }
+
+    // Type 0 logs all 50; type 1 logs every 4th of its 50.
+    REQUIRE(logger.getLoggedCount() == 50 + 12);
+    REQUIRE(logger.getSampledOutCount() == 38);
+    REQUIRE(static_cast<long>(logged.size()) == logger.getLoggedCount());
+    REQUIRE(logged[1] == 2);
+}
+
+TEST_CASE("LoggingHandler caps each type per one-second window", "[logging]")
+{
+    std::vector<long> logged;
+    auto logger = makeRecordingLogger(logged, 1, {1, 10});
+
+    for (long i = 0; i < 1000; ++i)
+    {
+        LogEvent event{0, i};
+        logger.onEvent(event, i, i == 999);
+    }
+    logger.onShutdown();
+
+    REQUIRE(logger.getLoggedCount() == 10);
+    REQUIRE(logger.getRateLimitedCount() == 990);
+    REQUIRE(logged.front() == 0);
+    REQUIRE(logged.back() == 9);
+}
+
+TEST_CASE("LoggingHandler routes unknown types to a shared bucket", "[logging]")
+{
+    std::vector<long> logged;
+    auto logger = makeRecordingLogger(logged, 1);
+    logger.setPolicy(1, {1, 2}); // index typeCount is the shared bucket
+
+    for (long i = 0; i < 10; ++i)
+    {
+        LogEvent event{7 + static_cast<int>(i % 3), i};
+        logger.onEvent(event, i, true);
+    }
+
+    REQUIRE(logger.getLoggedCount() == 2);
+    REQUIRE(logger.getRateLimitedCount() == 8);
+    REQUIRE_THROWS_AS(logger.setPolicy(2, {1, 0}), std::out_of_range);
+    REQUIRE_THROWS_AS(logger.setPolicy(0, {0, 0}), std::invalid_argument);
+}
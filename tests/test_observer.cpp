@@ -0,0 +1,160 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/observer.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+
+struct WideEvent
+{
+    long words[8]{};
+};
+
+// RingObserverTest - 测试非门控的乐观观察者：读取后校验、被套圈检测与跳跃
+
+namespace
+{
+void fill(WideEvent& event, long value)
+{
+    for (long& word : event.words)
+    {
+        word = value;
+    }
+}
+
+bool intact(const WideEvent& event, long sequence)
+{
+    for (long word : event.words)
+    {
+        if (word != sequence)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Producers publish flat out (nothing gates them) while one observer polls;
+ * every delivered copy must be untorn and the accounting must add up.
+ */
+void runObserverStress(disruptor::RingBuffer<WideEvent>& ringBuffer, int producers, long perProducer)
+{
+    disruptor::RingObserver<WideEvent> observer(ringBuffer, 64);
+    std::atomic<int> finished{0};
+    long torn = 0;
+    long lastSeen = -1;
+    bool ordered = true;
+
+    std::thread reader([&] {
+        while (finished.load(std::memory_order_acquire) < producers ||
+               observer.getNextSequence() <= ringBuffer.getCursor())
+        {
+            observer.poll([&](const WideEvent& event, long seq) {
+                torn += intact(event, seq) ? 0 : 1;
+                ordered = ordered && seq > lastSeen;
+                lastSeen = seq;
+            });
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int p = 0; p < producers; ++p)
+    {
+        writers.emplace_back([&] {
+            for (long i = 0; i < perProducer; ++i)
+            {
+                long seq = ringBuffer.next();
+                fill(ringBuffer.get(seq), seq);
+                ringBuffer.publish(seq);
+            }
+            finished.fetch_add(1, std::memory_order_release);
+        });
+    }
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+    reader.join();
+
+    REQUIRE(torn == 0);
+    REQUIRE(ordered);
+    REQUIRE(observer.getObservedCount() > 0);
+    REQUIRE(observer.getObservedCount() + observer.getLappedCount() == producers * perProducer);
+}
+}
+
+TEST_CASE("RingObserver sees every event while it keeps up", "[observer]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<WideEvent>::createSingleProducer([] { return WideEvent{}; }, 64, waitStrategy);
+    disruptor::RingObserver<WideEvent> observer(ringBuffer);
+
+    std::vector<long> seen;
+    for (long round = 0; round < 10; ++round)
+    {
+        for (int i = 0; i < 40; ++i)
+        {
+            long seq = ringBuffer.next();
+            fill(ringBuffer.get(seq), seq);
+            ringBuffer.publish(seq);
+        }
+        while (observer.poll([&](const WideEvent& event, long seq) {
+            REQUIRE(intact(event, seq));
+            seen.push_back(seq);
+        }) > 0)
+        {
+        }
+    }
+
+    REQUIRE(seen.size() == 400);
+    REQUIRE(seen.back() == 399);
+    REQUIRE(observer.getLappedCount() == 0);
+}
+
+TEST_CASE("RingObserver skips ahead after being lapped", "[observer]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<WideEvent>::createSingleProducer([] { return WideEvent{}; }, 16, waitStrategy);
+    disruptor::RingObserver<WideEvent> observer(ringBuffer);
+
+    // Not a gating sequence: the producer runs 100 events past the observer.
+    for (long i = 0; i < 100; ++i)
+    {
+        long seq = ringBuffer.next();
+        fill(ringBuffer.get(seq), seq);
+        ringBuffer.publish(seq);
+    }
+
+    std::vector<long> seen;
+    observer.poll([&](const WideEvent& event, long seq) {
+        REQUIRE(intact(event, seq));
+        seen.push_back(seq);
+    });
+
+    REQUIRE(seen.front() == 100 - 16);
+    REQUIRE(seen.back() == 99);
+    REQUIRE(observer.getLappedCount() == 100 - 16);
+    REQUIRE(observer.getNextSequence() == 100);
+}
+
+TEST_CASE("RingObserver never delivers torn events from a single producer", "[observer]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<WideEvent>::createSingleProducer([] { return WideEvent{}; }, 256, waitStrategy);
+    runObserverStress(ringBuffer, 1, 2'000'000);
+}
+
+TEST_CASE("RingObserver never delivers torn events from multiple producers", "[observer]")
+{
+    disruptor::BusySpinWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<WideEvent>::createMultiProducer([] { return WideEvent{}; }, 256, waitStrategy);
+    runObserverStress(ringBuffer, 2, 500'000);
+}
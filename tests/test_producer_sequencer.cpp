@@ -210,6 +210,59 @@ TEST_CASE("SingleProducerSequencer gating sequence management", "[sequencer][sin
     REQUIRE_FALSE(sequencer.removeGatingSequence(&gatingSeq));  // 已移除
 }
 
+TEST_CASE("SingleProducerSequencer gating set survives repeated evict and rejoin", "[sequencer][single]")
+{
+    constexpr int bufferSize = 64;
+    disruptor::BlockingWaitStrategy waitStrategy;
+    disruptor::SingleProducerSequencer sequencer(bufferSize, waitStrategy);
+
+    // 超过初始容量，触发扩容
+    std::vector<disruptor::Sequence> sequences(20);
+    for (size_t i = 0; i < sequences.size(); ++i)
+    {
+        sequences[i].set(static_cast<long>(100 + i));
+        sequencer.addGatingSequences({&sequences[i]});
+    }
+    REQUIRE(sequencer.getMinimumGatingSequence() == 100);
+
+    // 反复移除再加入最慢的消费者：槽位复用，最小值始终正确
+    disruptor::Sequence slow(5);
+    for (int round = 0; round < 10000; ++round)
+    {
+        sequencer.addGatingSequences({&slow});
+        REQUIRE(sequencer.getMinimumGatingSequence() == 5);
+        REQUIRE(sequencer.removeGatingSequence(&slow));
+        REQUIRE(sequencer.getMinimumGatingSequence() == 100);
+    }
+
+    for (auto& sequence : sequences)
+    {
+        REQUIRE(sequencer.removeGatingSequence(&sequence));
+    }
+    REQUIRE(sequencer.getMinimumGatingSequence() == sequencer.getCursor().get());
+}
+
+TEST_CASE("SingleProducerSequencer claim bound is conservative until tracking is enabled", "[sequencer][single]")
+{
+    constexpr int bufferSize = 16;
+    disruptor::BlockingWaitStrategy waitStrategy;
+    disruptor::SingleProducerSequencer sequencer(bufferSize, waitStrategy);
+
+    // 未开启跟踪：申请不写 claimed，上界按游标加一圈保守估计
+    sequencer.publish(sequencer.next(3));
+    REQUIRE(sequencer.getClaimBound() == 2 + bufferSize);
+
+    // 开启后、下一次申请前仍是保守值；申请后变为精确值
+    sequencer.enableClaimTracking();
+    sequencer.enableClaimTracking();
+    REQUIRE(sequencer.getClaimBound() == 2 + bufferSize);
+    long claimed = sequencer.next(2);
+    REQUIRE(sequencer.getClaimBound() == claimed);
+    sequencer.publish(claimed);
+    REQUIRE(sequencer.tryNext() == claimed + 1);
+    REQUIRE(sequencer.getClaimBound() == claimed + 1);
+}
+
 // ========== MultiProducerSequencerTest ==========
 TEST_CASE("MultiProducerSequencer should have correct buffer size", "[sequencer][multi]")
 {
@@ -366,6 +419,30 @@ TEST_CASE("MultiProducerSequencer batch publish", "[sequencer][multi]")
     }
 }
 
+TEST_CASE("MultiProducerSequencer batch publish across the wrap point", "[sequencer][multi]")
+{
+    constexpr int bufferSize = 8;
+    disruptor::BlockingWaitStrategy waitStrategy;
+    disruptor::MultiProducerSequencer sequencer(bufferSize, waitStrategy);
+
+    // 第一圈全部发布，第二圈从索引 5 开始跨越环尾
+    sequencer.publish(sequencer.next(bufferSize) - bufferSize + 1, bufferSize - 1);
+    long hi = sequencer.next(5);
+    REQUIRE(hi == 12);
+    sequencer.publish(8, 12);
+    hi = sequencer.next(bufferSize);
+    REQUIRE(hi == 20);
+    sequencer.publish(13, 20);  // 索引 5..7 和 0..4
+
+    for (long s = 13; s <= 20; ++s)
+    {
+        REQUIRE(sequencer.isAvailable(s));
+        REQUIRE_FALSE(sequencer.isAvailable(s - bufferSize));
+    }
+    REQUIRE(sequencer.getHighestPublishedSequence(13, 20) == 20);
+    REQUIRE_FALSE(sequencer.isAvailable(21));
+}
+
 TEST_CASE("MultiProducerSequencer hasAvailableCapacity", "[sequencer][multi]")
 {
     constexpr int bufferSize = 8;
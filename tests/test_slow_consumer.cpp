@@ -0,0 +1,240 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/slow_consumer.h"
+#include "disruptor/wait_strategy.h"
+
+struct BroadcastEvent
+{
+    long value{0};
+};
+
+// SlowConsumerMonitorTest - 测试广播拓扑中慢消费者的检测、剔除、套圈通知与重新加入
+
+namespace
+{
+class CountingHandler final : public disruptor::EventHandler<BroadcastEvent>
+{
+public:
+    void onEvent(BroadcastEvent& event, long sequence, bool) override
+    {
+        if (sequence == 0)
+        {
+            while (stallFirstEvent.load(std::memory_order_acquire))
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+        ordered = ordered && event.value == sequence;
+        seen.fetch_add(1, std::memory_order_release);
+    }
+
+    void onLapped(long firstSkipped, long lastSkipped) override
+    {
+        lappedRanges.emplace_back(firstSkipped, lastSkipped);
+        skipped.fetch_add(lastSkipped - firstSkipped + 1, std::memory_order_release);
+    }
+
+    std::atomic<bool> stallFirstEvent{false};
+    std::atomic<long> seen{0};
+    std::atomic<long> skipped{0};
+    bool ordered = true;
+    std::vector<std::pair<long, long>> lappedRanges;
+};
+}
+
+TEST_CASE("SlowConsumerMonitor evicts a stalled broadcast consumer so producers keep going", "[slow_consumer]")
+{
+    constexpr int bufferSize = 64;
+    constexpr long events = 100'000;
+
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<BroadcastEvent>::createSingleProducer([] { return BroadcastEvent{}; },
+                                                                                  bufferSize, waitStrategy);
+
+    CountingHandler fast1;
+    CountingHandler fast2;
+    CountingHandler slow;
+    slow.stallFirstEvent.store(true);
+
+    auto barrier1 = ringBuffer.newBarrier();
+    auto barrier2 = ringBuffer.newBarrier();
+    auto barrier3 = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<BroadcastEvent> processor1(ringBuffer, barrier1, fast1);
+    disruptor::BatchEventProcessor<BroadcastEvent> processor2(ringBuffer, barrier2, fast2);
+    disruptor::BatchEventProcessor<BroadcastEvent> slowProcessor(ringBuffer, barrier3, slow);
+    ringBuffer.addGatingSequences({&processor1.getSequence(), &processor2.getSequence(), &slowProcessor.getSequence()});
+
+    // A lag threshold would also catch healthy consumers the flat-out producer
+    // briefly runs ahead of; a stall does not.
+    disruptor::SlowConsumerPolicy policy;
+    policy.maxStall = std::chrono::milliseconds(50);
+    policy.checkInterval = std::chrono::milliseconds(1);
+    std::atomic<int> evictedNotices{0};
+    std::atomic<long> evictedLag{0};  // the producer was blocked on it
+    std::atomic<bool> evictedSlowOne{false};
+    disruptor::SlowConsumerMonitor<BroadcastEvent> monitor(
+        ringBuffer, policy, [&](disruptor::BatchEventProcessor<BroadcastEvent>& processor, long lag) {
+            evictedSlowOne.store(&processor == &slowProcessor);
+            evictedLag.store(lag);
+            evictedNotices.fetch_add(1);
+        });
+    monitor.watch(processor1);
+    monitor.watch(processor2);
+    monitor.watch(slowProcessor);
+    monitor.start();
+
+    std::thread t1([&] { processor1.run(); });
+    std::thread t2([&] { processor2.run(); });
+    std::thread t3([&] { slowProcessor.run(); });
+
+    // Without eviction this would block as soon as the ring wraps.
+    for (long i = 0; i < events; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq).value = i;
+        ringBuffer.publish(seq);
+    }
+    while (fast1.seen.load() < events || fast2.seen.load() < events)
+    {
+        std::this_thread::yield();
+    }
+    REQUIRE(slowProcessor.isEvicted());
+
+    // Let the slow consumer finish its event: it is told what it missed and rejoins.
+    slow.stallFirstEvent.store(false, std::memory_order_release);
+    while (slowProcessor.isEvicted() || slowProcessor.getSequence().get() < events - 1)
+    {
+        std::this_thread::yield();
+    }
+    monitor.stop();
+
+    processor1.halt();
+    processor2.halt();
+    slowProcessor.halt();
+    t1.join();
+    t2.join();
+    t3.join();
+
+    REQUIRE(fast1.ordered);
+    REQUIRE(fast2.ordered);
+    REQUIRE(monitor.getEvictionCount() == 1);
+    REQUIRE(evictedNotices.load() == 1);
+    REQUIRE(evictedSlowOne.load());
+    REQUIRE(evictedLag.load() == bufferSize);
+    REQUIRE(slow.lappedRanges.size() == 1);
+    REQUIRE(slow.lappedRanges[0].first == 1);
+    REQUIRE(slow.seen.load() + slow.skipped.load() == events);
+    REQUIRE(slowProcessor.getLappedCount() == slow.skipped.load());
+
+    // Back in the gating set: a producer may not run more than a buffer ahead of it.
+    REQUIRE(ringBuffer.getClaimBound() - slowProcessor.getSequence().get() <= bufferSize);
+}
+
+TEST_CASE("SlowConsumerMonitor evicts a consumer that stops making progress", "[slow_consumer]")
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<BroadcastEvent>::createSingleProducer([] { return BroadcastEvent{}; },
+                                                                                  1024, waitStrategy);
+    CountingHandler handler;
+    handler.stallFirstEvent.store(true);
+    auto barrier = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<BroadcastEvent> processor(ringBuffer, barrier, handler);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    disruptor::SlowConsumerPolicy policy;
+    policy.maxStall = std::chrono::milliseconds(20);
+    disruptor::SlowConsumerMonitor<BroadcastEvent> monitor(ringBuffer, policy);
+    monitor.watch(processor);
+
+    std::thread consumer([&] { processor.run(); });
+    for (long i = 0; i < 10; ++i)
+    {
+        long seq = ringBuffer.next();
+        ringBuffer.get(seq).value = i;
+        ringBuffer.publish(seq);
+    }
+
+    // A small lag is fine until the stall lasts longer than maxStall.
+    REQUIRE(monitor.checkOnce() == 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    REQUIRE(monitor.checkOnce() == 1);
+    REQUIRE(monitor.checkOnce() == 0);
+
+    handler.stallFirstEvent.store(false, std::memory_order_release);
+    while (processor.isEvicted())
+    {
+        std::this_thread::yield();
+    }
+    processor.halt();
+    consumer.join();
+
+    REQUIRE(handler.lappedRanges.size() == 1);
+    REQUIRE(handler.seen.load() + handler.skipped.load() == 10);
+}
+
+TEST_CASE("SlowConsumerMonitor evicts a consumer lagging more than maxLagSlots", "[slow_consumer]")
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<BroadcastEvent>::createSingleProducer([] { return BroadcastEvent{}; },
+                                                                                  64, waitStrategy);
+    CountingHandler fast;
+    CountingHandler slow;
+    slow.stallFirstEvent.store(true);
+    auto fastBarrier = ringBuffer.newBarrier();
+    auto slowBarrier = ringBuffer.newBarrier();
+    disruptor::BatchEventProcessor<BroadcastEvent> fastProcessor(ringBuffer, fastBarrier, fast);
+    disruptor::BatchEventProcessor<BroadcastEvent> slowProcessor(ringBuffer, slowBarrier, slow);
+    ringBuffer.addGatingSequences({&fastProcessor.getSequence(), &slowProcessor.getSequence()});
+
+    disruptor::SlowConsumerPolicy policy;
+    policy.maxLagSlots = 32;
+    disruptor::SlowConsumerMonitor<BroadcastEvent> monitor(ringBuffer, policy);
+    monitor.watch(fastProcessor);
+    monitor.watch(slowProcessor);
+
+    std::thread fastThread([&] { fastProcessor.run(); });
+    std::thread slowThread([&] { slowProcessor.run(); });
+
+    auto publish = [&](long count) {
+        for (long i = 0; i < count; ++i)
+        {
+            long seq = ringBuffer.next();
+            ringBuffer.get(seq).value = seq;
+            ringBuffer.publish(seq);
+        }
+        while (fast.seen.load() < ringBuffer.getCursor() + 1)
+        {
+            std::this_thread::yield();
+        }
+    };
+
+    publish(30);
+    REQUIRE(monitor.checkOnce() == 0);
+    publish(10);
+    REQUIRE(monitor.checkOnce() == 1);
+    REQUIRE(slowProcessor.isEvicted());
+    REQUIRE_FALSE(fastProcessor.isEvicted());
+
+    // Evicted: the producer now runs far past the stalled consumer.
+    publish(500);
+
+    slow.stallFirstEvent.store(false, std::memory_order_release);
+    while (slowProcessor.isEvicted() || slowProcessor.getSequence().get() < ringBuffer.getCursor())
+    {
+        std::this_thread::yield();
+    }
+    fastProcessor.halt();
+    slowProcessor.halt();
+    fastThread.join();
+    slowThread.join();
+
+    REQUIRE(slow.seen.load() + slow.skipped.load() == 540);
+    REQUIRE(fast.seen.load() == 540);
+}
@@ -0,0 +1,186 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/batch_event_processor.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/udp_egress.h"
+#include "disruptor/udp_ingest.h"
+#include "disruptor/wait_strategy.h"
+
+using Packet = disruptor::Datagram<64>;
+
+// UdpTest - 测试基于 recvmmsg/sendmmsg 的 UDP 收发直接读写 RingBuffer 槽位（回环地址）
+
+namespace
+{
+/**
+ * Bound loopback UDP socket with a receive timeout; port 0 picks a free port.
+ */
+int openLoopbackSocket(sockaddr_in& address)
+{
+    int fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+    REQUIRE(fd >= 0);
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    REQUIRE(::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0);
+    socklen_t length = sizeof(address);
+    REQUIRE(::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) == 0);
+
+    timeval timeout{0, 20'000};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    int bufferBytes = 4 << 20;
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferBytes, sizeof(bufferBytes));
+    return fd;
+}
+
+class PacketCollector final : public disruptor::EventHandler<Packet>
+{
+public:
+    void onEvent(Packet& packet, long, bool) override
+    {
+        if (packet.length == 0)
+        {
+            return;
+        }
+        payloads.emplace_back(packet.data, packet.length);
+        truncated += packet.truncated ? 1 : 0;
+        count.store(static_cast<long>(payloads.size()), std::memory_order_release);
+    }
+
+    std::vector<std::string> payloads;
+    long truncated = 0;
+    std::atomic<long> count{0};
+};
+}
+
+TEST_CASE("UdpIngest receives loopback datagrams straight into ring slots", "[udp]")
+{
+    constexpr int datagrams = 600;
+    constexpr int burst = 40;
+
+    sockaddr_in address;
+    int receiver = openLoopbackSocket(address);
+    int sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+    REQUIRE(sender >= 0);
+
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<Packet>::createSingleProducer([] { return Packet{}; }, 256, waitStrategy);
+    auto barrier = ringBuffer.newBarrier();
+    PacketCollector collector;
+    disruptor::BatchEventProcessor<Packet> processor(ringBuffer, barrier, collector);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+    std::thread consumer([&] { processor.run(); });
+
+    std::atomic<bool> running{true};
+    disruptor::UdpIngest<Packet> ingest(ringBuffer, receiver, 32);
+    std::thread producer([&] { ingest.run(running); });
+
+    std::string oversized(100, 'x');
+    for (int sent = 0; sent < datagrams;)
+    {
+        for (int i = 0; i < burst; ++i, ++sent)
+        {
+            std::string payload = sent == 7 ? oversized : "msg-" + std::to_string(sent);
+            REQUIRE(::sendto(sender, payload.data(), payload.size(), 0, reinterpret_cast<sockaddr*>(&address),
+                             sizeof(address)) == static_cast<ssize_t>(payload.size()));
+        }
+        while (collector.count.load(std::memory_order_acquire) < sent)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    running.store(false, std::memory_order_release);
+    producer.join();
+    processor.halt();
+    consumer.join();
+    ::close(sender);
+    ::close(receiver);
+
+    REQUIRE(ingest.getPublishedCount() == datagrams);
+    REQUIRE(ingest.getTruncatedCount() == 1);
+    REQUIRE(collector.truncated == 1);
+    REQUIRE(collector.payloads[7] == oversized.substr(0, 64));
+    for (int i = 0; i < datagrams; ++i)
+    {
+        if (i != 7)
+        {
+            REQUIRE(collector.payloads[static_cast<size_t>(i)] == "msg-" + std::to_string(i));
+        }
+    }
+    // Bursts arrive together, so recvmmsg should return several per call.
+    REQUIRE(ingest.getReceiveCalls() < datagrams);
+}
+
+TEST_CASE("UdpEgressHandler sends each batch with sendmmsg from ring slots", "[udp]")
+{
+    constexpr int datagrams = 500;
+    constexpr int burst = 50;
+
+    sockaddr_in address;
+    int receiver = openLoopbackSocket(address);
+    int sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+    REQUIRE(sender >= 0);
+
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer = disruptor::RingBuffer<Packet>::createSingleProducer([] { return Packet{}; }, 128, waitStrategy);
+    auto barrier = ringBuffer.newBarrier();
+    disruptor::UdpEgressHandler<Packet> egress(sender, reinterpret_cast<sockaddr*>(&address), sizeof(address), 32);
+    disruptor::BatchEventProcessor<Packet> processor(ringBuffer, barrier, egress);
+    ringBuffer.addGatingSequences({&processor.getSequence()});
+
+    std::thread consumer([&] { processor.run(); });
+
+    std::vector<std::string> received;
+    char buffer[128];
+    for (int published = 0; published < datagrams;)
+    {
+        // One publish(lo, hi) per burst, so the handler sees each burst as one batch.
+        long hi = ringBuffer.next(burst);
+        long lo = hi - burst + 1;
+        for (long seq = lo; seq <= hi; ++seq, ++published)
+        {
+            std::string payload = "out-" + std::to_string(published);
+            Packet& packet = ringBuffer.get(seq);
+            std::memcpy(packet.data, payload.data(), payload.size());
+            packet.length = static_cast<uint32_t>(payload.size());
+        }
+        ringBuffer.publish(lo, hi);
+
+        while (static_cast<int>(received.size()) < published)
+        {
+            ssize_t n = ::recv(receiver, buffer, sizeof(buffer), 0);
+            if (n > 0)
+            {
+                received.emplace_back(buffer, static_cast<size_t>(n));
+            }
+        }
+    }
+    processor.halt();
+    consumer.join();
+    ::close(sender);
+    ::close(receiver);
+
+    REQUIRE(static_cast<int>(received.size()) == datagrams);
+    for (int i = 0; i < datagrams; ++i)
+    {
+        REQUIRE(received[static_cast<size_t>(i)] == "out-" + std::to_string(i));
+    }
+    REQUIRE(egress.getSentCount() == datagrams);
+    // 50-event batches flushed at maxBatch 32: two sendmmsg calls per batch.
+    REQUIRE(egress.getSendCalls() <= 2 * datagrams / burst);
+}
@@ -0,0 +1,139 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "disruptor/exception_handler.h"
+#include "disruptor/exceptions.h"
+#include "disruptor/ring_buffer.h"
+#include "disruptor/wait_strategy.h"
+#include "disruptor/worker_pool.h"
+
+struct WorkEvent
+{
+    long value{0};
+};
+
+// WorkerPoolTest - 测试工作池的序号认领、生产者门控与关闭流程
+
+namespace
+{
+class CountingWorkHandler final : public disruptor::WorkHandler<WorkEvent>
+{
+public:
+    void onEvent(WorkEvent&, long) override
+    {
+        processed.fetch_add(1, std::memory_order_release);
+    }
+
+    std::atomic<long> processed{0};
+};
+
+class ThrowingWorkHandler final : public disruptor::WorkHandler<WorkEvent>
+{
+public:
+    void onEvent(WorkEvent&, long) override
+    {
+        throw std::runtime_error("bad event");
+    }
+
+    void onShutdown() override
+    {
+        shutdowns.fetch_add(1, std::memory_order_release);
+    }
+
+    std::atomic<int> shutdowns{0};
+};
+}
+
+TEST_CASE("WorkerPool keeps the producer going with more workers than ring slots", "[worker_pool]")
+{
+    // 工作者数多于环大小：总有工作者首次认领的序号超出一圈。
+    // 若其门控序列仍停在初始值，生产者永远无法发布到该序号，形成死锁。
+    constexpr long events = 1000;
+    constexpr int workers = 6;
+
+    disruptor::YieldingWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<WorkEvent>::createMultiProducer([] { return WorkEvent{}; }, 4, waitStrategy);
+
+    std::vector<CountingWorkHandler> handlers(workers);
+    std::vector<disruptor::WorkHandler<WorkEvent>*> handlerPointers;
+    for (auto& handler : handlers)
+    {
+        handlerPointers.push_back(&handler);
+    }
+    disruptor::WorkerPool<WorkEvent> pool(ringBuffer, handlerPointers);
+    ringBuffer.addGatingSequences(pool.getWorkerSequences());
+    pool.start();
+
+    // 用 tryNext 加超时发布，死锁时测试失败而不是挂起
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    long published = 0;
+    while (published < events && std::chrono::steady_clock::now() < deadline)
+    {
+        try
+        {
+            long seq = ringBuffer.tryNext();
+            ringBuffer.get(seq).value = published;
+            ringBuffer.publish(seq);
+            ++published;
+        }
+        catch (const disruptor::InsufficientCapacityException&)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    auto processed = [&] {
+        long total = 0;
+        for (auto& handler : handlers)
+        {
+            total += handler.processed.load(std::memory_order_acquire);
+        }
+        return total;
+    };
+    while (processed() < published && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::yield();
+    }
+    pool.halt();
+    pool.join();
+
+    REQUIRE(published == events);
+    REQUIRE(processed() == events);
+}
+
+TEST_CASE("WorkProcessor calls onShutdown when the exception handler rethrows", "[worker_pool]")
+{
+    disruptor::BlockingWaitStrategy waitStrategy;
+    auto ringBuffer =
+        disruptor::RingBuffer<WorkEvent>::createMultiProducer([] { return WorkEvent{}; }, 8, waitStrategy);
+    ThrowingWorkHandler handler;
+    disruptor::Sequence workSequence{disruptor::Sequence::INITIAL_VALUE};
+    disruptor::WorkProcessor<WorkEvent> processor(ringBuffer, ringBuffer.newBarrier(), handler, workSequence);
+    disruptor::FatalExceptionHandler<WorkEvent> fatal;
+    processor.setExceptionHandler(fatal);
+
+    std::atomic<bool> threw{false};
+    std::thread worker([&] {
+        try
+        {
+            processor.run();
+        }
+        catch (const std::runtime_error&)
+        {
+            threw.store(true);
+        }
+    });
+    ringBuffer.publish(ringBuffer.next());
+    worker.join();
+
+    // 异常处理器重新抛出后工作者停止，但 onShutdown 仍被调用一次
+    REQUIRE(threw.load());
+    REQUIRE(handler.shutdowns.load() == 1);
+    REQUIRE_FALSE(processor.isRunning());
+}